@@ -0,0 +1,98 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <qtils/append.hpp>
+#include <qtils/bytes_chain.hpp>
+
+using qtils::benchmark::bytes_sizes;
+using qtils::benchmark::random_bytes;
+using qtils::benchmark::set_bytes_processed;
+
+namespace {
+  // appends to empty buffer
+  template <typename T>
+  void append(benchmark::State &state) {
+    auto bytes = random_bytes(state.range(0));
+    for (auto _ : state) {
+      T out;
+      qtils::append(out, bytes);
+      benchmark::DoNotOptimize(out.data());
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+
+  // builds buffer from 32 byte pieces
+  template <typename T>
+  void append_pieces(benchmark::State &state) {
+    auto bytes = random_bytes(state.range(0));
+    constexpr size_t kPiece = 32;
+    for (auto _ : state) {
+      T out;
+      for (size_t i = 0; i < bytes.size(); i += kPiece) {
+        qtils::append(out, qtils::BytesIn{bytes}.subspan(i, kPiece));
+      }
+      benchmark::DoNotOptimize(out.data());
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+
+  // builds buffer from prefix, key and 32 byte value per call
+  template <typename T>
+  void append_variadic(benchmark::State &state) {
+    auto bytes = random_bytes(state.range(0));
+    qtils::BytesN<32> key{};
+    constexpr size_t kPiece = 32;
+    for (auto _ : state) {
+      T out;
+      for (size_t i = 0; i < bytes.size(); i += kPiece) {
+        qtils::append(out,
+            uint8_t{0x80},
+            key,
+            qtils::BytesIn{bytes}.subspan(i, kPiece));
+      }
+      benchmark::DoNotOptimize(out.data());
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+
+  // frame of header, payload and trailer, copied into one buffer
+  void frame_append(benchmark::State &state) {
+    auto payload = random_bytes(state.range(0));
+    qtils::BytesN<16> header{}, trailer{};
+    for (auto _ : state) {
+      qtils::Bytes frame;
+      qtils::append(frame, header, payload, trailer);
+      benchmark::DoNotOptimize(frame.data());
+    }
+    set_bytes_processed(state, payload.size());
+  }
+
+  // same frame as segments ready for `writev`
+  void frame_chain(benchmark::State &state) {
+    auto payload = random_bytes(state.range(0));
+    qtils::BytesN<16> header{}, trailer{};
+    for (auto _ : state) {
+      qtils::BytesChain frame;
+      frame.push_back(payload);
+      frame.push_front(header);
+      frame.push_back(trailer);
+      auto iovecs = frame.iovecs();
+      benchmark::DoNotOptimize(iovecs.data());
+    }
+    set_bytes_processed(state, payload.size());
+  }
+}  // namespace
+
+BENCHMARK_TEMPLATE(append, qtils::Bytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(append, qtils::UninitBytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(append_pieces, qtils::Bytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(append_pieces, qtils::UninitBytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(append_variadic, qtils::Bytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(append_variadic, qtils::UninitBytes)->Apply(bytes_sizes);
+BENCHMARK(frame_append)->Apply(bytes_sizes);
+BENCHMARK(frame_chain)->Apply(bytes_sizes);
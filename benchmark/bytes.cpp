@@ -0,0 +1,170 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <qtils/arena.hpp>
+#include <qtils/bytes_pool.hpp>
+#include <qtils/mapped_bytes.hpp>
+#include <qtils/shared_bytes.hpp>
+
+using qtils::benchmark::bytes_sizes;
+using qtils::benchmark::random_bytes;
+using qtils::benchmark::set_bytes_processed;
+
+namespace {
+  // resize buffer which is overwritten right after
+  template <typename T>
+  void resize_overwrite(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _ : state) {
+      T bytes;
+      qtils::resize_uninitialized(bytes, size);
+      memset(bytes.data(), 0xab, size);
+      benchmark::DoNotOptimize(bytes.data());
+    }
+    set_bytes_processed(state, size);
+  }
+
+  // grow reused buffer, like `append` to cleared buffer
+  template <typename T>
+  void resize_overwrite_reused(benchmark::State &state) {
+    size_t size = state.range(0);
+    T bytes;
+    bytes.reserve(size);
+    for (auto _ : state) {
+      bytes.clear();
+      qtils::resize_uninitialized(bytes, size);
+      memset(bytes.data(), 0xab, size);
+      benchmark::DoNotOptimize(bytes.data());
+    }
+    set_bytes_processed(state, size);
+  }
+
+  // many short-lived 64 byte buffers per "block"
+  constexpr size_t kTemporarySize = 64;
+
+  void temporaries_heap(benchmark::State &state) {
+    size_t count = state.range(0) / kTemporarySize;
+    std::vector<qtils::Bytes> buffers;
+    buffers.reserve(count);
+    for (auto _ : state) {
+      for (size_t i = 0; i < count; ++i) {
+        auto &bytes = buffers.emplace_back();
+        qtils::resize_uninitialized(bytes, kTemporarySize);
+        benchmark::DoNotOptimize(bytes.data());
+      }
+      buffers.clear();
+    }
+    set_bytes_processed(state, state.range(0));
+  }
+
+  void temporaries_arena(benchmark::State &state) {
+    size_t count = state.range(0) / kTemporarySize;
+    qtils::Arena arena;
+    std::vector<qtils::pmr::Bytes> buffers;
+    buffers.reserve(count);
+    for (auto _ : state) {
+      qtils::ArenaScope scope{arena};
+      for (size_t i = 0; i < count; ++i) {
+        auto &bytes = buffers.emplace_back(&arena);
+        qtils::resize_uninitialized(bytes, kTemporarySize);
+        benchmark::DoNotOptimize(bytes.data());
+      }
+      buffers.clear();
+    }
+    set_bytes_processed(state, state.range(0));
+  }
+
+  // same message queued to many peers
+  constexpr size_t kPeers = 50;
+
+  template <typename T>
+  void fanout(benchmark::State &state) {
+    T message{random_bytes(state.range(0))};
+    std::vector<T> queues;
+    queues.reserve(kPeers);
+    for (auto _ : state) {
+      for (size_t i = 0; i < kPeers; ++i) {
+        queues.emplace_back(message);
+      }
+      benchmark::DoNotOptimize(queues.data());
+      queues.clear();
+    }
+    set_bytes_processed(state, kPeers * message.size());
+  }
+
+  // temporary file with random content, removed on destruction
+  struct TempFile {
+    explicit TempFile(size_t size)
+        : path{std::filesystem::temp_directory_path()
+               / "qtils_benchmark_mapped"} {
+      auto bytes = random_bytes(size);
+      std::ofstream{path, std::ios::binary}.write(
+          reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    }
+    ~TempFile() {
+      std::filesystem::remove(path);
+    }
+    std::filesystem::path path;
+  };
+
+  // open file and read first and last byte
+  void load_read(benchmark::State &state) {
+    TempFile file(state.range(0));
+    for (auto _ : state) {
+      std::ifstream stream{file.path, std::ios::binary};
+      qtils::Bytes bytes(state.range(0));
+      stream.read(reinterpret_cast<char *>(bytes.data()), bytes.size());
+      benchmark::DoNotOptimize(bytes.front() + bytes.back());
+    }
+    set_bytes_processed(state, state.range(0));
+  }
+
+  void load_mapped(benchmark::State &state) {
+    TempFile file(state.range(0));
+    for (auto _ : state) {
+      auto bytes = qtils::MappedBytes::open(file.path).value();
+      benchmark::DoNotOptimize(bytes.view().front() + bytes.view().back());
+    }
+    set_bytes_processed(state, state.range(0));
+  }
+
+  // allocate, fill header and free buffer of common size
+  template <typename T>
+  void churn(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _ : state) {
+      T bytes;
+      qtils::resize_uninitialized(bytes, size);
+      bytes[0] = 1;
+      benchmark::DoNotOptimize(bytes.data());
+    }
+    set_bytes_processed(state, size);
+  }
+
+  void churn_sizes(benchmark::internal::Benchmark *b) {
+    b->Arg(4 << 10)->Arg(64 << 10)->Arg(1 << 20)->ThreadRange(1, 4);
+  }
+}  // namespace
+
+BENCHMARK_TEMPLATE(resize_overwrite, qtils::Bytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(resize_overwrite, qtils::UninitBytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(resize_overwrite_reused, qtils::Bytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(resize_overwrite_reused, qtils::UninitBytes)
+    ->Apply(bytes_sizes);
+BENCHMARK(temporaries_heap)->Apply(bytes_sizes);
+BENCHMARK(temporaries_arena)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(fanout, qtils::Bytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(fanout, qtils::SharedBytes)->Apply(bytes_sizes);
+BENCHMARK(load_read)->Apply(bytes_sizes);
+BENCHMARK(load_mapped)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(churn, qtils::UninitBytes)->Apply(churn_sizes);
+BENCHMARK_TEMPLATE(churn, qtils::PooledBytes)->Apply(churn_sizes);
@@ -0,0 +1,98 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include <qtils/bytes_cache.hpp>
+#include <qtils/shared_bytes.hpp>
+
+using qtils::benchmark::random_bytes;
+
+namespace {
+  using Hash32 = qtils::BytesN<32>;
+
+  constexpr size_t kKeys = 1 << 14;
+  constexpr size_t kValueSize = 64;
+  constexpr size_t kCapacity = 2 * kKeys * kValueSize;
+
+  const std::vector<Hash32> &keys() {
+    static const auto keys = [] {
+      auto bytes = random_bytes(kKeys * 32);
+      std::vector<Hash32> keys(kKeys);
+      for (size_t i = 0; i < kKeys; ++i) {
+        memcpy(keys[i].data(), bytes.data() + i * 32, 32);
+      }
+      return keys;
+    }();
+    return keys;
+  }
+
+  // baseline: one mutex around map
+  struct MutexCache {
+    explicit MutexCache(size_t) {}
+
+    std::optional<qtils::SharedBytes> get(qtils::BytesIn key) {
+      std::lock_guard lock{mutex};
+      auto it = map.find(key);
+      if (it == map.end()) {
+        return std::nullopt;
+      }
+      return it->second;
+    }
+    void put(const Hash32 &key, qtils::SharedBytes value) {
+      std::lock_guard lock{mutex};
+      map.insert_or_assign(key, std::move(value));
+    }
+
+    std::mutex mutex;
+    std::unordered_map<Hash32,
+        qtils::SharedBytes,
+        qtils::RandomBytesHash,
+        qtils::BytesEqual>
+        map;
+  };
+
+  using ShardedCache =
+      qtils::BytesCache<Hash32, qtils::SharedBytes, qtils::RandomBytesHash>;
+
+  template <typename Cache>
+  Cache &filled_cache() {
+    static auto cache = [] {
+      auto cache = std::make_unique<Cache>(kCapacity);
+      qtils::SharedBytes value{random_bytes(kValueSize)};
+      for (auto &key : keys()) {
+        cache->put(key, value);
+      }
+      return cache;
+    }();
+    return *cache;
+  }
+
+  // parallel reads with 1 write per 16 reads
+  template <typename Cache>
+  void cache_get(benchmark::State &state) {
+    auto &cache = filled_cache<Cache>();
+    auto &keys = ::keys();
+    qtils::SharedBytes value{random_bytes(kValueSize)};
+    size_t i = state.thread_index() * 7919;
+    for (auto _ : state) {
+      auto &key = keys[i++ % kKeys];
+      if (i % 16 == 0) {
+        cache.put(key, value);
+      } else {
+        benchmark::DoNotOptimize(cache.get(key));
+      }
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+}  // namespace
+
+BENCHMARK_TEMPLATE(cache_get, MutexCache)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(cache_get, ShardedCache)->ThreadRange(1, 8)->UseRealTime();
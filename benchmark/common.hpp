@@ -0,0 +1,49 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <qtils/bytes.hpp>
+
+namespace qtils::benchmark {
+  inline Bytes random_bytes(size_t size) {
+    std::mt19937 random{static_cast<uint32_t>(size)};
+    Bytes bytes(size);
+    for (auto &byte : bytes) {
+      byte = random();
+    }
+    return bytes;
+  }
+
+  // Storage-like keys: one of 16 random 32 byte prefixes (pallet and item
+  // hashes), then 32 to 63 random bytes.
+  inline std::vector<Bytes> storage_keys(size_t count) {
+    auto prefixes = random_bytes(16 * 32);
+    auto bytes = random_bytes(count * 64);
+    std::vector<Bytes> keys(count);
+    for (size_t i = 0; i < count; ++i) {
+      auto prefix = prefixes.begin() + bytes[i * 64] % 16 * 32;
+      auto tail = bytes.begin() + i * 64;
+      keys[i].assign(prefix, prefix + 32);
+      keys[i].insert(keys[i].end(), tail, tail + 32 + bytes[i * 64 + 1] % 32);
+    }
+    return keys;
+  }
+
+  // 32 B to 16 MiB
+  inline void bytes_sizes(::benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(16)->Range(32, 16 << 20);
+  }
+
+  inline void set_bytes_processed(::benchmark::State &state, size_t size) {
+    state.SetBytesProcessed(state.iterations() * size);
+  }
+}  // namespace qtils::benchmark
@@ -0,0 +1,78 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <cstring>
+#include <map>
+
+#include <qtils/bytes_compare.hpp>
+
+using qtils::benchmark::random_bytes;
+
+namespace {
+  constexpr size_t kKeys = 1 << 12;
+
+  // pairs of keys, equal in all but last byte, worst case for compare
+  template <size_t N>
+  std::vector<qtils::BytesN<N>> similar_keys() {
+    auto bytes = random_bytes(N);
+    std::vector<qtils::BytesN<N>> keys(kKeys);
+    for (size_t i = 0; i < kKeys; ++i) {
+      memcpy(keys[i].data(), bytes.data(), N);
+      keys[i][N - 1] = i % 2;
+    }
+    return keys;
+  }
+
+  template <size_t N>
+  void compare_std(benchmark::State &state) {
+    auto keys = similar_keys<N>();
+    size_t i = 0;
+    for (auto _ : state) {
+      auto &l = keys[i++ % kKeys], &r = keys[i % kKeys];
+      benchmark::DoNotOptimize(l == r);
+      benchmark::DoNotOptimize(l <=> r);
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  template <size_t N>
+  void compare_bytes(benchmark::State &state) {
+    auto keys = similar_keys<N>();
+    size_t i = 0;
+    for (auto _ : state) {
+      auto &l = keys[i++ % kKeys], &r = keys[i % kKeys];
+      benchmark::DoNotOptimize(qtils::bytes_equal(l, r));
+      benchmark::DoNotOptimize(qtils::bytes_compare(l, r));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // sorted map of 32 byte random keys
+  template <typename Less>
+  void compare_map_find(benchmark::State &state) {
+    auto bytes = random_bytes(kKeys * 32);
+    std::vector<qtils::BytesN<32>> keys(kKeys);
+    std::map<qtils::BytesN<32>, size_t, Less> map;
+    for (size_t i = 0; i < kKeys; ++i) {
+      memcpy(keys[i].data(), bytes.data() + i * 32, 32);
+      map.emplace(keys[i], i);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(map.find(keys[i++ % kKeys]));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+}  // namespace
+
+BENCHMARK_TEMPLATE(compare_std, 32);
+BENCHMARK_TEMPLATE(compare_bytes, 32);
+BENCHMARK_TEMPLATE(compare_std, 64);
+BENCHMARK_TEMPLATE(compare_bytes, 64);
+BENCHMARK_TEMPLATE(compare_map_find, std::less<>);
+BENCHMARK_TEMPLATE(compare_map_find, qtils::BytesLess);
@@ -0,0 +1,30 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <qtils/error.hpp>
+#include <qtils/unhex.hpp>
+
+using qtils::benchmark::bytes_sizes;
+
+namespace {
+  // formats one error code per 32 bytes of size
+  void error_code_format(benchmark::State &state) {
+    std::error_code error = qtils::UnhexError::NON_HEX;
+    auto count = state.range(0) / 32;
+    for (auto _ : state) {
+      fmt::memory_buffer buffer;
+      for (int64_t i = 0; i < count; ++i) {
+        fmt::format_to(fmt::appender(buffer), "{}", error);
+      }
+      benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  }
+}  // namespace
+
+BENCHMARK(error_code_format)->Apply(bytes_sizes);
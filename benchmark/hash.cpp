@@ -0,0 +1,114 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <cstring>
+#include <unordered_map>
+
+#include <qtils/bytes_hash.hpp>
+#include <qtils/flat_bytes_map.hpp>
+
+using qtils::BytesEqual;
+using qtils::BytesHash;
+using qtils::RandomBytesHash;
+using qtils::benchmark::random_bytes;
+
+namespace {
+  constexpr size_t kKeys = 1 << 16;
+  constexpr size_t kKeySize = 32;
+
+  template <typename Key>
+  std::vector<Key> random_keys() {
+    auto bytes = random_bytes(kKeys * kKeySize);
+    std::vector<Key> keys(kKeys);
+    for (size_t i = 0; i < kKeys; ++i) {
+      if constexpr (qtils::ResizableBytes<Key>) {
+        keys[i].resize(kKeySize);
+      }
+      memcpy(keys[i].data(), bytes.data() + i * kKeySize, kKeySize);
+    }
+    return keys;
+  }
+
+  template <typename Key, typename Hash>
+  std::unordered_map<Key, size_t, Hash, BytesEqual> make_map(
+      const std::vector<Key> &keys) {
+    std::unordered_map<Key, size_t, Hash, BytesEqual> map;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      map.emplace(keys[i], i);
+    }
+    return map;
+  }
+
+  // lookup of 32 byte hash
+  template <typename Hash>
+  void hash_find(benchmark::State &state) {
+    auto keys = random_keys<qtils::BytesN<kKeySize>>();
+    auto map = make_map<qtils::BytesN<kKeySize>, Hash>(keys);
+    size_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(map.find(keys[i++ % kKeys]));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // same lookup in flat swiss table
+  void hash_find_flat(benchmark::State &state) {
+    auto keys = random_keys<qtils::BytesN<kKeySize>>();
+    qtils::FlatBytesMap<kKeySize, size_t> map;
+    for (size_t i = 0; i < kKeys; ++i) {
+      map.try_emplace(keys[i], i);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(map.find(keys[i++ % kKeys]));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // fill map from empty
+  template <typename Map>
+  void hash_insert(benchmark::State &state) {
+    auto keys = random_keys<qtils::BytesN<kKeySize>>();
+    for (auto _ : state) {
+      Map map;
+      for (size_t i = 0; i < kKeys; ++i) {
+        map.try_emplace(keys[i], i);
+      }
+      benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * kKeys);
+  }
+
+  // lookup in map keyed by `Bytes` with borrowed `BytesIn`,
+  // or copying key to temporary `Bytes`
+  template <bool kCopy>
+  void hash_find_bytes(benchmark::State &state) {
+    auto keys = random_keys<qtils::Bytes>();
+    auto map = make_map<qtils::Bytes, BytesHash>(keys);
+    size_t i = 0;
+    for (auto _ : state) {
+      qtils::BytesIn key = keys[i++ % kKeys];
+      if constexpr (kCopy) {
+        qtils::Bytes copy(key.begin(), key.end());
+        benchmark::DoNotOptimize(map.find(copy));
+      } else {
+        benchmark::DoNotOptimize(map.find(key));
+      }
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+}  // namespace
+
+BENCHMARK_TEMPLATE(hash_find, BytesHash);
+BENCHMARK_TEMPLATE(hash_find, RandomBytesHash);
+BENCHMARK(hash_find_flat);
+BENCHMARK_TEMPLATE(hash_insert,
+    std::unordered_map<qtils::BytesN<32>, size_t, RandomBytesHash, BytesEqual>);
+BENCHMARK_TEMPLATE(hash_insert, qtils::FlatBytesMap<32, size_t>);
+BENCHMARK_TEMPLATE(hash_find_bytes, false);
+BENCHMARK_TEMPLATE(hash_find_bytes, true);
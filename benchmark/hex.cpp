@@ -0,0 +1,128 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <qtils/aligned_bytes.hpp>
+#include <qtils/append.hpp>
+#include <qtils/hex.hpp>
+
+using qtils::benchmark::bytes_sizes;
+using qtils::benchmark::random_bytes;
+using qtils::benchmark::set_bytes_processed;
+
+namespace {
+  void format(benchmark::State &state, std::string_view spec) {
+    auto bytes = random_bytes(state.range(0));
+    for (auto _ : state) {
+      fmt::memory_buffer buffer;
+      fmt::format_to(fmt::appender(buffer), fmt::runtime(spec), bytes);
+      benchmark::DoNotOptimize(buffer.data());
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+
+  void hex_format_truncated(benchmark::State &state) {
+    format(state, "{}");
+  }
+
+  void hex_format_full(benchmark::State &state) {
+    format(state, "{:x}");
+  }
+
+  void hex_format_full_upper(benchmark::State &state) {
+    format(state, "{:X}");
+  }
+
+  // fmt formatter before simd encoder
+  void hex_format_join(benchmark::State &state) {
+    auto bytes = random_bytes(state.range(0));
+    for (auto _ : state) {
+      fmt::memory_buffer buffer;
+      fmt::format_to(fmt::appender(buffer), "{:02x}", fmt::join(bytes, ""));
+      benchmark::DoNotOptimize(buffer.data());
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+
+  // block hash
+  template <bool kFixed>
+  void hex_format_hash(benchmark::State &state, std::string_view spec) {
+    qtils::BytesN<32> hash;
+    std::ranges::copy(random_bytes(hash.size()), hash.begin());
+    for (auto _ : state) {
+      fmt::memory_buffer buffer;
+      if constexpr (kFixed) {
+        fmt::format_to(fmt::appender(buffer), fmt::runtime(spec), hash);
+      } else {
+        fmt::format_to(
+            fmt::appender(buffer), fmt::runtime(spec), qtils::BytesIn{hash});
+      }
+      benchmark::DoNotOptimize(buffer.data());
+    }
+    set_bytes_processed(state, hash.size());
+  }
+
+  void hex_format_hash_truncated(benchmark::State &state) {
+    hex_format_hash<true>(state, "{}");
+  }
+
+  void hex_format_hash_full(benchmark::State &state) {
+    hex_format_hash<true>(state, "{:0x}");
+  }
+
+  void hex_format_hash_span_truncated(benchmark::State &state) {
+    hex_format_hash<false>(state, "{}");
+  }
+
+  void hex_format_hash_span_full(benchmark::State &state) {
+    hex_format_hash<false>(state, "{:0x}");
+  }
+
+  void hex_string(benchmark::State &state) {
+    auto bytes = random_bytes(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(qtils::hex(bytes));
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+
+  void hex_to(benchmark::State &state) {
+    auto bytes = random_bytes(state.range(0));
+    std::string buffer(2 * bytes.size(), '\0');
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(qtils::hex_to(buffer, bytes));
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+
+  // input at cache line boundary or shifted by `kOffset`
+  template <size_t kOffset>
+  void hex_to_aligned(benchmark::State &state) {
+    qtils::AlignedBytes<> aligned;
+    aligned.resize(kOffset);
+    qtils::append(aligned, random_bytes(state.range(0)));
+    auto bytes = qtils::BytesIn{aligned}.subspan(kOffset);
+    std::string buffer(2 * bytes.size(), '\0');
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(qtils::hex_to(buffer, bytes));
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+}  // namespace
+
+BENCHMARK(hex_format_truncated)->Apply(bytes_sizes);
+BENCHMARK(hex_format_full)->Apply(bytes_sizes);
+BENCHMARK(hex_format_full_upper)->Apply(bytes_sizes);
+BENCHMARK(hex_format_join)->Apply(bytes_sizes);
+BENCHMARK(hex_format_hash_truncated);
+BENCHMARK(hex_format_hash_full);
+BENCHMARK(hex_format_hash_span_truncated);
+BENCHMARK(hex_format_hash_span_full);
+BENCHMARK(hex_string)->Apply(bytes_sizes);
+BENCHMARK(hex_to)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(hex_to_aligned, 0)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(hex_to_aligned, 1)->Apply(bytes_sizes);
@@ -0,0 +1,70 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <cstdlib>
+
+#include <qtils/enum_error_code.hpp>
+#include <qtils/outcome.hpp>
+
+using qtils::benchmark::bytes_sizes;
+using qtils::benchmark::random_bytes;
+using qtils::benchmark::set_bytes_processed;
+
+namespace {
+  enum class BenchmarkError {
+    FAILED,
+  };
+  Q_ENUM_ERROR_CODE(BenchmarkError) {
+    using E = decltype(e);
+    switch (e) {
+      case E::FAILED:
+        return "FAILED";
+    }
+    abort();
+  }
+
+  // keeps compiler from folding propagation
+  [[gnu::noinline]] outcome::result<qtils::Bytes> produce(
+      const qtils::Bytes &bytes, bool fail) {
+    if (fail) {
+      return BenchmarkError::FAILED;
+    }
+    return bytes;
+  }
+
+  [[gnu::noinline]] outcome::result<qtils::Bytes> propagate(
+      const qtils::Bytes &bytes, bool fail) {
+    OUTCOME_TRY(r, produce(bytes, fail));
+    return r;
+  }
+
+  [[gnu::noinline]] outcome::result<void> propagate_void(
+      const qtils::Bytes &bytes, bool fail) {
+    OUTCOME_TRY(propagate(bytes, fail));
+    return outcome::success();
+  }
+
+  void outcome_try(benchmark::State &state, bool fail) {
+    auto bytes = random_bytes(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(propagate_void(bytes, fail));
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+
+  void outcome_try_success(benchmark::State &state) {
+    outcome_try(state, false);
+  }
+
+  void outcome_try_failure(benchmark::State &state) {
+    outcome_try(state, true);
+  }
+}  // namespace
+
+BENCHMARK(outcome_try_success)->Apply(bytes_sizes);
+BENCHMARK(outcome_try_failure)->Apply(bytes_sizes);
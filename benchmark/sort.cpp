@@ -0,0 +1,75 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <qtils/bytes_compare.hpp>
+#include <qtils/radix_sort.hpp>
+
+using qtils::benchmark::random_bytes;
+using qtils::benchmark::storage_keys;
+
+namespace {
+  using Hash32 = qtils::BytesN<32>;
+
+  std::vector<Hash32> random_hashes(size_t count) {
+    auto bytes = random_bytes(count * 32);
+    std::vector<Hash32> hashes(count);
+    for (size_t i = 0; i < count; ++i) {
+      memcpy(hashes[i].data(), bytes.data() + i * 32, 32);
+    }
+    return hashes;
+  }
+
+  enum class Sort { STD, RADIX, RADIX_STABLE, RADIX_PARALLEL };
+
+  template <Sort kSort, typename T>
+  void sort(benchmark::State &state, const std::vector<T> &input) {
+    for (auto _ : state) {
+      state.PauseTiming();
+      auto keys = input;
+      state.ResumeTiming();
+      if constexpr (kSort == Sort::STD) {
+        std::sort(keys.begin(), keys.end(), qtils::BytesLess{});
+      } else if constexpr (kSort == Sort::RADIX) {
+        qtils::radix_sort(keys);
+      } else if constexpr (kSort == Sort::RADIX_STABLE) {
+        qtils::stable_radix_sort(keys);
+      } else {
+        qtils::radix_sort(keys, 4);
+      }
+      benchmark::DoNotOptimize(keys.data());
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+  }
+
+  template <Sort kSort>
+  void sort_hashes(benchmark::State &state) {
+    sort<kSort>(state, random_hashes(state.range(0)));
+  }
+
+  template <Sort kSort>
+  void sort_storage_keys(benchmark::State &state) {
+    sort<kSort>(state, storage_keys(state.range(0)));
+  }
+
+  void sort_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->UseRealTime();
+  }
+}  // namespace
+
+BENCHMARK_TEMPLATE(sort_hashes, Sort::STD)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(sort_hashes, Sort::RADIX)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(sort_hashes, Sort::RADIX_STABLE)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(sort_hashes, Sort::RADIX_PARALLEL)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(sort_storage_keys, Sort::STD)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(sort_storage_keys, Sort::RADIX)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(sort_storage_keys, Sort::RADIX_STABLE)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(sort_storage_keys, Sort::RADIX_PARALLEL)
+    ->Apply(sort_sizes);
@@ -0,0 +1,116 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <map>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <qtils/bytes_compare.hpp>
+#include <qtils/radix_tree.hpp>
+
+using qtils::benchmark::storage_keys;
+
+namespace {
+  using StdMap = std::map<qtils::Bytes, uint64_t, qtils::BytesLess>;
+  using RadixTree = qtils::RadixTree<uint64_t>;
+
+  // Heap bytes in use, 0 where allocator can't tell.
+  size_t heap_used() {
+#ifdef __GLIBC__
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+  }
+
+  template <typename It>
+  qtils::BytesIn key_of(const It &it) {
+    if constexpr (requires { it.key(); }) {
+      return it.key();
+    } else {
+      return it->first;
+    }
+  }
+
+  template <typename Index>
+  Index make_index(const std::vector<qtils::Bytes> &keys) {
+    Index index;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      index.try_emplace(keys[i], i);
+    }
+    return index;
+  }
+
+  template <typename Index>
+  void tree_insert(benchmark::State &state) {
+    auto keys = storage_keys(state.range(0));
+    size_t heap = 0;
+    for (auto _ : state) {
+      auto before = heap_used();
+      auto index = make_index<Index>(keys);
+      heap = heap_used() - before;
+      state.PauseTiming();
+      index = Index{};
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+    state.counters["heap_per_key"] = static_cast<double>(heap) / keys.size();
+  }
+
+  template <typename Index>
+  void tree_find(benchmark::State &state) {
+    auto keys = storage_keys(state.range(0));
+    auto index = make_index<Index>(keys);
+    for (auto _ : state) {
+      for (auto &key : keys) {
+        benchmark::DoNotOptimize(index.find(key));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+  }
+
+  // `state_getKeysPaged`: up to 1000 keys with prefix from start key.
+  template <typename Index>
+  void tree_scan(benchmark::State &state) {
+    constexpr size_t kPage = 1000;
+    auto keys = storage_keys(state.range(0));
+    auto index = make_index<Index>(keys);
+    size_t i = 0;
+    size_t visited = 0;
+    for (auto _ : state) {
+      auto &start = keys[i++ % keys.size()];
+      qtils::BytesIn prefix{start.data(), 32};
+      size_t page = 0;
+      for (auto it = index.lower_bound(start);
+          it != index.end() and page < kPage;
+          ++it, ++page) {
+        auto key = key_of(it);
+        if (key.size() < prefix.size()
+            or not qtils::bytes_equal(key.first(prefix.size()), prefix)) {
+          break;
+        }
+        benchmark::DoNotOptimize(key.data());
+      }
+      visited += page;
+    }
+    state.SetItemsProcessed(visited);
+  }
+
+  void tree_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+  }
+}  // namespace
+
+BENCHMARK_TEMPLATE(tree_insert, StdMap)->Apply(tree_sizes);
+BENCHMARK_TEMPLATE(tree_insert, RadixTree)->Apply(tree_sizes);
+BENCHMARK_TEMPLATE(tree_find, StdMap)->Apply(tree_sizes);
+BENCHMARK_TEMPLATE(tree_find, RadixTree)->Apply(tree_sizes);
+BENCHMARK_TEMPLATE(tree_scan, StdMap)->Apply(tree_sizes);
+BENCHMARK_TEMPLATE(tree_scan, RadixTree)->Apply(tree_sizes);
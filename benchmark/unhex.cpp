@@ -0,0 +1,68 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.hpp"
+
+#include <qtils/hex.hpp>
+#include <qtils/unhex.hpp>
+
+using qtils::benchmark::bytes_sizes;
+using qtils::benchmark::random_bytes;
+using qtils::benchmark::set_bytes_processed;
+
+namespace {
+  template <typename T>
+  void unhex(benchmark::State &state) {
+    auto str = qtils::hex(random_bytes(state.range(0)));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(qtils::unhex<T>(str).value());
+    }
+    set_bytes_processed(state, str.size() / 2);
+  }
+
+  void unhex0x(benchmark::State &state) {
+    auto str = qtils::hex0x(random_bytes(state.range(0)));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(qtils::unhex0x(str).value());
+    }
+    set_bytes_processed(state, str.size() / 2 - 1);
+  }
+
+  // non-hex char at the end, after everything else was decoded
+  void unhex_invalid(benchmark::State &state) {
+    auto str = qtils::hex(random_bytes(state.range(0)));
+    str.back() = 'g';
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(qtils::unhex(str).has_error());
+    }
+    set_bytes_processed(state, str.size() / 2);
+  }
+
+  void unhex0x_invalid(benchmark::State &state) {
+    auto str = qtils::hex0x(random_bytes(state.range(0)));
+    str.back() = 'g';
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(qtils::unhex0x(str).has_error());
+    }
+    set_bytes_processed(state, str.size() / 2 - 1);
+  }
+
+  void unhex_to(benchmark::State &state) {
+    auto bytes = random_bytes(state.range(0));
+    auto str = qtils::hex(bytes);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(qtils::unhex_to(bytes, str).value());
+    }
+    set_bytes_processed(state, bytes.size());
+  }
+}  // namespace
+
+BENCHMARK_TEMPLATE(unhex, qtils::Bytes)->Apply(bytes_sizes);
+BENCHMARK_TEMPLATE(unhex, qtils::UninitBytes)->Apply(bytes_sizes);
+BENCHMARK(unhex0x)->Apply(bytes_sizes);
+BENCHMARK(unhex_invalid)->Apply(bytes_sizes);
+BENCHMARK(unhex0x_invalid)->Apply(bytes_sizes);
+BENCHMARK(unhex_to)->Apply(bytes_sizes);
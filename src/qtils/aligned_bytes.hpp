@@ -0,0 +1,77 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <bit>
+#include <new>
+
+#include <qtils/bytes.hpp>
+#include <qtils/bytes_hash.hpp>
+#include <qtils/hex.hpp>
+
+namespace qtils {
+  inline constexpr size_t kCacheLine = 64;
+
+  inline bool is_aligned(const void *ptr, size_t align) {
+    return reinterpret_cast<uintptr_t>(ptr) % align == 0;
+  }
+
+  // Whether span starts at `Align` boundary, e.g. for aligned simd loads.
+  template <size_t Align>
+  bool is_aligned(BytesIn bytes) {
+    static_assert(std::has_single_bit(Align));
+    return is_aligned(bytes.data(), Align);
+  }
+
+  template <typename T, size_t Align>
+  class AlignedAllocator {
+    static_assert(std::has_single_bit(Align) and Align >= alignof(T));
+
+   public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+      using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align> &) {}
+
+    T *allocate(size_t n) {
+      return static_cast<T *>(
+          ::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+    void deallocate(T *ptr, size_t) {
+      ::operator delete(ptr, std::align_val_t{Align});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align> &) const {
+      return true;
+    }
+  };
+
+  // `Bytes` which data starts at `Align` boundary.
+  template <size_t Align = kCacheLine>
+  using AlignedBytes = std::vector<uint8_t, AlignedAllocator<uint8_t, Align>>;
+
+  // `BytesN` placed at `Align` boundary.
+  template <size_t N, size_t Align = kCacheLine>
+  struct alignas(Align) AlignedBytesN : BytesN<N> {};
+}  // namespace qtils
+
+template <size_t Align>
+struct fmt::formatter<qtils::AlignedBytes<Align>>
+    : fmt::formatter<qtils::BytesIn> {};
+template <size_t N, size_t Align>
+struct fmt::formatter<qtils::AlignedBytesN<N, Align>>
+    : fmt::formatter<qtils::BytesN<N>> {};
+
+template <size_t N, size_t Align>
+struct std::hash<qtils::AlignedBytesN<N, Align>> : qtils::BytesHash {};
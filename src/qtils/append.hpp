@@ -6,13 +6,60 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <qtils/bytes.hpp>
+#include <qtils/bytestr.hpp>
+
+namespace qtils::detail {
+  inline BytesIn append_piece(BytesIn bytes) {
+    return bytes;
+  }
+
+  // Exact type, so `int` doesn't silently narrow to byte.
+  template <std::same_as<uint8_t> T>
+  BytesIn append_piece(const T &byte) {
+    return {&byte, 1};
+  }
+
+  inline BytesIn append_piece(std::string_view s) {
+    return str2byte(s);
+  }
+}  // namespace qtils::detail
 
 namespace qtils {
-  inline void append(Bytes &l, BytesIn r) {
+  /**
+   * Appends pieces (bytes, single `uint8_t` or `std::string_view`) to `l`
+   * with at most one reallocation.
+   * Capacity grows at least twice, so repeated appends are linear.
+   * Pieces must not point into `l`.
+   */
+  template <ResizableBytes T, typename... Pieces>
+  void append(T &l, const Pieces &...pieces) {
+    std::array<BytesIn, sizeof...(Pieces)> spans{
+        detail::append_piece(pieces)...};
     auto offset = l.size();
-    l.resize(offset + r.size());
-    memcpy(l.data() + offset, r.data(), r.size());
+    auto size = offset;
+    for (auto &span : spans) {
+      size += span.size();
+    }
+    if constexpr (requires { l.reserve(l.capacity()); }) {
+      if (size > l.capacity()) {
+        l.reserve(std::max(size, 2 * l.capacity()));
+      }
+    }
+    resize_uninitialized(l, size);
+    for (auto &span : spans) {
+      if (not span.empty()) {
+        memcpy(l.data() + offset, span.data(), span.size());
+        offset += span.size();
+      }
+    }
+  }
+
+  template <ResizableBytes T>
+  void append(T &l, BytesIn r) {
+    append<T, BytesIn>(l, r);
   }
 }  // namespace qtils
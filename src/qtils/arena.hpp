@@ -0,0 +1,52 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory_resource>
+
+#include <qtils/bytes.hpp>
+
+namespace qtils {
+  /**
+   * Monotonic arena for buffers which die together (e.g. per block).
+   * Allocation bumps pointer, deallocation is no-op,
+   * `release` frees everything at once.
+   * Not thread-safe.
+   * Pass `&arena` as memory resource: `pmr::Bytes bytes{&arena}`.
+   */
+  class Arena : public std::pmr::monotonic_buffer_resource {
+   public:
+    static constexpr size_t kDefaultChunk = 64 << 10;
+
+    explicit Arena(size_t chunk = kDefaultChunk,
+        std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+        : monotonic_buffer_resource{chunk, upstream} {}
+
+    pmr::Bytes bytes(size_t size = 0) {
+      pmr::Bytes bytes{this};
+      bytes.resize(size);
+      return bytes;
+    }
+  };
+
+  /**
+   * Releases arena on scope exit.
+   * Buffers allocated from arena must not outlive scope.
+   */
+  class ArenaScope {
+   public:
+    explicit ArenaScope(Arena &arena) : arena_{arena} {}
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+    ~ArenaScope() {
+      arena_.release();
+    }
+
+   private:
+    Arena &arena_;
+  };
+}  // namespace qtils
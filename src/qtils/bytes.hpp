@@ -7,8 +7,13 @@
 #pragma once
 
 #include <array>
+#include <concepts>
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace qtils {
@@ -17,4 +22,60 @@ namespace qtils {
   using BytesN = std::array<uint8_t, N>;
   using BytesIn = std::span<const uint8_t>;
   using BytesOut = std::span<uint8_t>;
+
+  // Allocator which default-initializes, so `resize` doesn't zero-fill.
+  template <typename T, typename A = std::allocator<T>>
+  class DefaultInitAllocator : public A {
+    using Traits = std::allocator_traits<A>;
+
+   public:
+    template <typename U>
+    struct rebind {
+      using other =
+          DefaultInitAllocator<U, typename Traits::template rebind_alloc<U>>;
+    };
+
+    using A::A;
+
+    template <typename U>
+    void construct(U *ptr) noexcept(
+        std::is_nothrow_default_constructible_v<U>) {
+      ::new (static_cast<void *>(ptr)) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U *ptr, Args &&...args) {
+      Traits::construct(
+          static_cast<A &>(*this), ptr, std::forward<Args>(args)...);
+    }
+  };
+
+  // `Bytes` with uninitialized `resize`, for buffers overwritten anyway.
+  using UninitBytes = std::vector<uint8_t, DefaultInitAllocator<uint8_t>>;
+
+  namespace pmr {
+    // `Bytes` allocated from memory resource, e.g. `qtils::Arena`.
+    using Bytes = std::pmr::vector<uint8_t>;
+  }  // namespace pmr
+
+  // Contiguous byte container which can be resized, like `Bytes`.
+  template <typename T>
+  concept ResizableBytes = requires(T &t, size_t size) {
+    t.resize(size);
+    { t.data() } -> std::same_as<uint8_t *>;
+    { t.size() } -> std::convertible_to<size_t>;
+  };
+
+  /**
+   * Resizes without zero-filling new bytes when container supports it
+   * (`UninitBytes`, `SmallBytes`).
+   * `Bytes` still zero-fills.
+   */
+  template <ResizableBytes T>
+  void resize_uninitialized(T &t, size_t size) {
+    if constexpr (requires { t.resize_uninitialized(size); }) {
+      t.resize_uninitialized(size);
+    } else {
+      t.resize(size);
+    }
+  }
 }  // namespace qtils
@@ -0,0 +1,298 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <qtils/bytes.hpp>
+#include <qtils/bytes_compare.hpp>
+#include <qtils/bytes_hash.hpp>
+
+namespace qtils {
+  // Bytes held by cached value: size for byte containers, `sizeof` otherwise.
+  template <typename V>
+  size_t cache_weight(const V &value) {
+    if constexpr (std::is_convertible_v<const V &, BytesIn>) {
+      return BytesIn{value}.size();
+    } else {
+      return sizeof(V);
+    }
+  }
+
+  /**
+   * Thread-safe cache keyed by `Bytes` or `BytesN<N>`, looked up by `BytesIn`.
+   * Sharded by key hash, each shard has own `shared_mutex`.
+   * Reads take shared lock and only set CLOCK reference bit, so they run in
+   * parallel; writes take exclusive lock of one shard.
+   * Capacity is total weight of values (see `cache_weight`), split evenly
+   * between shards, so single value may weigh at most `shard_capacity()`.
+   * `get` copies value out, use cheap to copy values (e.g. `SharedBytes`)
+   * or `visit`.
+   */
+  template <typename Key, typename V, typename Hash = BytesHash>
+  class BytesCache {
+   public:
+    struct Stats {
+      size_t hits = 0;
+      size_t misses = 0;
+      size_t evictions = 0;
+      size_t size = 0;
+      size_t weight = 0;
+    };
+
+    // Default shard capacity is at least this, unless whole cache is smaller.
+    static constexpr size_t kMinShardCapacity = 8 << 20;
+
+    /**
+     * `shards = 0` picks power of two above twice the hardware threads, but
+     * no more than leaves `kMinShardCapacity` per shard.
+     */
+    explicit BytesCache(size_t capacity, size_t shards = 0)
+        : shard_count_{shards != 0 ? std::bit_ceil(shards)
+                                   : default_shards(capacity)},
+          shards_{std::make_unique<Shard[]>(shard_count_)} {
+      for (size_t i = 0; i < shard_count_; ++i) {
+        shards_[i].capacity = capacity / shard_count_;
+      }
+    }
+
+    std::optional<V> get(BytesIn key) const {
+      std::optional<V> value;
+      visit(key, [&](const V &v) { value = v; });
+      return value;
+    }
+
+    // Calls `f(const V &)` under shared lock when key is cached.
+    template <typename F>
+    bool visit(BytesIn key, const F &f) const {
+      auto &shard = shard_of(key);
+      std::shared_lock lock{shard.mutex};
+      auto it = shard.map.find(key);
+      if (it == shard.map.end()) {
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      it->second.referenced.store(true, std::memory_order_relaxed);
+      shard.hits.fetch_add(1, std::memory_order_relaxed);
+      f(it->second.value);
+      return true;
+    }
+
+    bool contains(BytesIn key) const {
+      auto &shard = shard_of(key);
+      std::shared_lock lock{shard.mutex};
+      return shard.map.contains(key);
+    }
+
+    /**
+     * Inserts or replaces value, evicting until shard fits capacity.
+     * Returns false when value alone exceeds `shard_capacity()`, it isn't
+     * cached.
+     */
+    bool put(const Key &key, V value) {
+      auto weight = cache_weight(value);
+      return put(key, std::move(value), weight);
+    }
+
+    bool put(const Key &key, V value, size_t weight) {
+      auto &shard = shard_of(key);
+      std::unique_lock lock{shard.mutex};
+      if (weight > shard.capacity) {
+        shard.erase(key);
+        return false;
+      }
+      if (auto it = shard.map.find(key); it != shard.map.end()) {
+        auto &entry = it->second;
+        shard.weight -= entry.weight;
+        entry.value = std::move(value);
+        entry.weight = weight;
+        entry.referenced.store(true, std::memory_order_relaxed);
+        shard.evict(weight, &*it);
+        shard.weight += weight;
+        return true;
+      }
+      shard.evict(weight);
+      auto node = &*shard.map.try_emplace(key, std::move(value)).first;
+      node->second.weight = weight;
+      shard.link(node);
+      shard.weight += weight;
+      return true;
+    }
+
+    bool erase(BytesIn key) {
+      auto &shard = shard_of(key);
+      std::unique_lock lock{shard.mutex};
+      return shard.erase(key);
+    }
+
+    void clear() {
+      for (size_t i = 0; i < shard_count_; ++i) {
+        auto &shard = shards_[i];
+        std::unique_lock lock{shard.mutex};
+        shard.map.clear();
+        shard.ring.clear();
+        shard.hand = 0;
+        shard.weight = 0;
+      }
+    }
+
+    size_t shard_count() const {
+      return shard_count_;
+    }
+
+    // Capacity of each shard, also max weight of single value.
+    size_t shard_capacity() const {
+      return shards_[0].capacity;
+    }
+
+    Stats shard_stats(size_t i) const {
+      auto &shard = shards_[i];
+      std::shared_lock lock{shard.mutex};
+      return {
+          shard.hits.load(std::memory_order_relaxed),
+          shard.misses.load(std::memory_order_relaxed),
+          shard.evictions,
+          shard.map.size(),
+          shard.weight,
+      };
+    }
+
+    // Sum of all shards.
+    Stats stats() const {
+      Stats total;
+      for (size_t i = 0; i < shard_count_; ++i) {
+        auto stats = shard_stats(i);
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.evictions += stats.evictions;
+        total.size += stats.size;
+        total.weight += stats.weight;
+      }
+      return total;
+    }
+
+   private:
+    struct Entry {
+      explicit Entry(V &&value) : value{std::move(value)} {}
+
+      V value;
+      size_t weight = 0;
+      // Index in `Shard::ring`.
+      size_t position = 0;
+      // Set by readers under shared lock, cleared by CLOCK hand.
+      mutable std::atomic<bool> referenced = false;
+    };
+
+    using Map = std::unordered_map<Key, Entry, Hash, BytesEqual>;
+    using Node = typename Map::value_type;
+
+    struct alignas(64) Shard {
+      bool erase(BytesIn key) {
+        auto it = map.find(key);
+        if (it == map.end()) {
+          return false;
+        }
+        remove(it->second.position);
+        return true;
+      }
+
+      /**
+       * Second-chance sweep until `incoming` more weight fits: entry at hand
+       * is evicted, or moved to ring end if referenced. `keep` (entry being
+       * replaced) is never evicted.
+       */
+      void evict(size_t incoming, const Node *keep = nullptr) {
+        while (weight + incoming > capacity) {
+          auto position = hand++;
+          auto node = ring[position];
+          if (node == nullptr) {
+            continue;
+          }
+          if (node == keep
+              or node->second.referenced.exchange(
+                  false, std::memory_order_relaxed)) {
+            ring[position] = nullptr;
+            link(node);
+            continue;
+          }
+          remove(position);
+          ++evictions;
+        }
+      }
+
+      // Leaves hole in ring, so other entries keep their CLOCK order.
+      void remove(size_t position) {
+        auto node = ring[position];
+        weight -= node->second.weight;
+        ring[position] = nullptr;
+        map.erase(map.find(node->first));
+      }
+
+      // New entry goes to ring end, so it is swept last.
+      void link(Node *node) {
+        if (ring.size() >= 2 * map.size() + 16) {
+          compact();
+        }
+        node->second.position = ring.size();
+        ring.push_back(node);
+      }
+
+      // Drops swept slots and holes, runs once ring is twice live entries.
+      void compact() {
+        size_t size = 0;
+        for (size_t i = hand; i < ring.size(); ++i) {
+          if (auto node = ring[i]) {
+            node->second.position = size;
+            ring[size++] = node;
+          }
+        }
+        ring.resize(size);
+        hand = 0;
+      }
+
+      mutable std::shared_mutex mutex;
+      Map map;
+      /**
+       * Stable pointers into `map` nodes in CLOCK order from `hand`, null for
+       * holes. Slots before `hand` are swept and null.
+       */
+      std::vector<Node *> ring;
+      size_t hand = 0;
+      size_t weight = 0;
+      size_t capacity = 0;
+      size_t evictions = 0;
+      mutable std::atomic<size_t> hits = 0;
+      mutable std::atomic<size_t> misses = 0;
+    };
+
+    static size_t default_shards(size_t capacity) {
+      size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+      return std::min(std::bit_ceil(2 * threads),
+          std::bit_floor(std::max<size_t>(capacity / kMinShardCapacity, 1)));
+    }
+
+    Shard &shard_of(BytesIn key) const {
+      auto hash = Hash{}(key);
+      // Mix high bits, low bits also pick map bucket.
+      hash ^= hash >> 29;
+      hash *= 0x9e3779b97f4a7c15;
+      return shards_[(hash >> 32) & (shard_count_ - 1)];
+    }
+
+    size_t shard_count_;
+    std::unique_ptr<Shard[]> shards_;
+  };
+}  // namespace qtils
@@ -0,0 +1,185 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstring>
+#include <deque>
+#include <ranges>
+#include <sys/uio.h>
+#include <variant>
+
+#include <qtils/bytes.hpp>
+#include <qtils/shared_bytes.hpp>
+
+namespace qtils::detail {
+  // Rvalue of container owning its bytes, lvalues and views like `BytesIn`
+  // are borrowed ranges.
+  template <typename T>
+  concept OwningTemporary = std::convertible_to<T, BytesIn>
+                        and not std::ranges::borrowed_range<T>;
+}  // namespace qtils::detail
+
+namespace qtils {
+  /**
+   * Sequence of borrowed or owned byte segments, e.g. frame header, payload
+   * and trailer, written with `writev` without copying payload.
+   * Borrowed segments must outlive chain.
+   * Move-only, because segments point into owned buffers.
+   */
+  class BytesChain {
+   public:
+    BytesChain() = default;
+    BytesChain(BytesChain &&) = default;
+    BytesChain &operator=(BytesChain &&) = default;
+    BytesChain(const BytesChain &) = delete;
+    BytesChain &operator=(const BytesChain &) = delete;
+
+    void push_back(BytesIn bytes) {
+      push<false>(bytes, {});
+    }
+    void push_back(Bytes &&bytes) {
+      push<false>({}, std::move(bytes));
+    }
+    void push_back(SharedBytes bytes) {
+      push<false>({}, std::move(bytes));
+    }
+    // Temporary which owns its bytes would dangle once borrowed.
+    template <detail::OwningTemporary T>
+    void push_back(T &&) = delete;
+
+    void push_front(BytesIn bytes) {
+      push<true>(bytes, {});
+    }
+    void push_front(Bytes &&bytes) {
+      push<true>({}, std::move(bytes));
+    }
+    void push_front(SharedBytes bytes) {
+      push<true>({}, std::move(bytes));
+    }
+    template <detail::OwningTemporary T>
+    void push_front(T &&) = delete;
+
+    // Total number of bytes.
+    size_t size() const {
+      return size_;
+    }
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    // Range of `BytesIn`, one per non-empty segment.
+    auto segments() const {
+      return std::views::transform(segments_, &Segment::bytes);
+    }
+    size_t segment_count() const {
+      return segments_.size();
+    }
+
+    /**
+     * Fills `out` with segments starting from `first`.
+     * Returns number of filled entries, call again with `first` advanced
+     * when `out` is shorter than `segment_count()` (e.g. IOV_MAX).
+     */
+    size_t iovecs(std::span<iovec> out, size_t first = 0) const {
+      size_t count = 0;
+      first = std::min(first, segments_.size());
+      for (auto it = segments_.begin() + first;
+          it != segments_.end() and count < out.size();
+          ++it) {
+        out[count++] = {
+            const_cast<uint8_t *>(it->bytes.data()),
+            it->bytes.size(),
+        };
+      }
+      return count;
+    }
+
+    std::vector<iovec> iovecs() const {
+      std::vector<iovec> out(segments_.size());
+      iovecs(out);
+      return out;
+    }
+
+    // Drops `n` leading bytes, e.g. after partial `writev`.
+    void consume(size_t n) {
+      n = std::min(n, size_);
+      size_ -= n;
+      while (n != 0) {
+        auto &front = segments_.front();
+        if (n < front.bytes.size()) {
+          front.bytes = front.bytes.subspan(n);
+          return;
+        }
+        n -= front.bytes.size();
+        segments_.pop_front();
+      }
+    }
+
+    void clear() {
+      segments_.clear();
+      size_ = 0;
+    }
+
+    // Copies segments into contiguous buffer.
+    Bytes flatten() const & {
+      Bytes out;
+      out.reserve(size_);
+      for (auto &segment : segments_) {
+        out.insert(out.end(), segment.bytes.begin(), segment.bytes.end());
+      }
+      return out;
+    }
+
+    // Moves single whole owned segment out without copying.
+    Bytes flatten() && {
+      if (segments_.size() == 1) {
+        auto &segment = segments_.front();
+        if (auto bytes = std::get_if<Bytes>(&segment.owner);
+            bytes and bytes->data() == segment.bytes.data()
+            and bytes->size() == segment.bytes.size()) {
+          auto out = std::move(*bytes);
+          clear();
+          return out;
+        }
+      }
+      auto out = flatten();
+      clear();
+      return out;
+    }
+
+   private:
+    using Owner = std::variant<std::monostate, Bytes, SharedBytes>;
+
+    struct Segment {
+      BytesIn bytes;
+      Owner owner;
+    };
+
+    template <bool front>
+    void push(BytesIn bytes, Owner &&owner) {
+      Segment segment{bytes, std::move(owner)};
+      // Owned buffer doesn't move with segment, so view stays valid.
+      if (auto owned = std::get_if<Bytes>(&segment.owner)) {
+        segment.bytes = *owned;
+      } else if (auto shared = std::get_if<SharedBytes>(&segment.owner)) {
+        segment.bytes = *shared;
+      }
+      if (segment.bytes.empty()) {
+        return;
+      }
+      size_ += segment.bytes.size();
+      if constexpr (front) {
+        segments_.emplace_front(std::move(segment));
+      } else {
+        segments_.emplace_back(std::move(segment));
+      }
+    }
+
+    std::deque<Segment> segments_;
+    size_t size_ = 0;
+  };
+}  // namespace qtils
@@ -0,0 +1,152 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstring>
+
+#include <qtils/bytes.hpp>
+
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
+namespace qtils::detail {
+  /**
+   * 32 and 64 byte keys (hashes, public keys) get unrolled simd compare.
+   * Width is chosen at compile time: SSE2 on any x86-64 build, AVX2 only
+   * with `-mavx2` (or `-march` which implies it).
+   * Unlike hex kernels it isn't dispatched by `simd_level()`: `target`
+   * function can't be inlined, and call costs more than the compare.
+   */
+  template <size_t N>
+  constexpr bool kSimdCompare = N == 32 or N == 64;
+
+#ifdef __SSE2__
+  template <size_t N>
+  bool simd_equal(const uint8_t *l, const uint8_t *r) {
+#ifdef __AVX2__
+    auto eq = _mm256_set1_epi8(-1);
+    for (size_t i = 0; i < N; i += 32) {
+      eq = _mm256_and_si256(eq,
+          _mm256_cmpeq_epi8(
+              _mm256_loadu_si256(reinterpret_cast<const __m256i *>(l + i)),
+              _mm256_loadu_si256(reinterpret_cast<const __m256i *>(r + i))));
+    }
+    return static_cast<uint32_t>(_mm256_movemask_epi8(eq)) == 0xffffffff;
+#else
+    auto eq = _mm_set1_epi8(-1);
+    for (size_t i = 0; i < N; i += 16) {
+      eq = _mm_and_si128(eq,
+          _mm_cmpeq_epi8(
+              _mm_loadu_si128(reinterpret_cast<const __m128i *>(l + i)),
+              _mm_loadu_si128(reinterpret_cast<const __m128i *>(r + i))));
+    }
+    return _mm_movemask_epi8(eq) == 0xffff;
+#endif
+  }
+
+  // Bit `i` is set when byte `i` differs.
+  template <size_t N>
+  uint64_t simd_diff_mask(const uint8_t *l, const uint8_t *r) {
+    uint64_t mask = 0;
+#ifdef __AVX2__
+    for (size_t i = 0; i < N; i += 32) {
+      auto eq = _mm256_cmpeq_epi8(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(l + i)),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(r + i)));
+      uint32_t diff = ~static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+      mask |= uint64_t{diff} << i;
+    }
+#else
+    for (size_t i = 0; i < N; i += 16) {
+      auto eq = _mm_cmpeq_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(l + i)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(r + i)));
+      uint32_t diff = ~_mm_movemask_epi8(eq) & 0xffff;
+      mask |= uint64_t{diff} << i;
+    }
+#endif
+    return mask;
+  }
+#endif
+}  // namespace qtils::detail
+
+namespace qtils {
+  inline bool bytes_equal(BytesIn l, BytesIn r) {
+    return l.size() == r.size()
+       and (l.empty() or memcmp(l.data(), r.data(), l.size()) == 0);
+  }
+
+  template <size_t N>
+  bool bytes_equal(const BytesN<N> &l, const BytesN<N> &r) {
+#ifdef __SSE2__
+    if constexpr (detail::kSimdCompare<N>) {
+      return detail::simd_equal<N>(l.data(), r.data());
+    }
+#endif
+    return memcmp(l.data(), r.data(), N) == 0;
+  }
+
+  // Lexicographic, shorter prefix is less.
+  inline std::strong_ordering bytes_compare(BytesIn l, BytesIn r) {
+    auto n = std::min(l.size(), r.size());
+    if (n != 0) {
+      if (auto c = memcmp(l.data(), r.data(), n); c != 0) {
+        return c <=> 0;
+      }
+    }
+    return l.size() <=> r.size();
+  }
+
+  template <size_t N>
+  std::strong_ordering bytes_compare(const BytesN<N> &l, const BytesN<N> &r) {
+#ifdef __SSE2__
+    if constexpr (detail::kSimdCompare<N>) {
+      auto mask = detail::simd_diff_mask<N>(l.data(), r.data());
+      if (mask == 0) {
+        return std::strong_ordering::equal;
+      }
+      auto i = std::countr_zero(mask);
+      return l[i] <=> r[i];
+    }
+#endif
+    return memcmp(l.data(), r.data(), N) <=> 0;
+  }
+
+  /**
+   * Transparent equality for `Bytes`, `BytesN`, `BytesIn` and `BytesOut`.
+   * `std::span` has no `operator==`, and operators can't be added for std
+   * types, so use this or `bytes_equal`.
+   */
+  struct BytesEqual {
+    using is_transparent = void;
+
+    bool operator()(BytesIn l, BytesIn r) const {
+      return bytes_equal(l, r);
+    }
+    template <size_t N>
+    bool operator()(const BytesN<N> &l, const BytesN<N> &r) const {
+      return bytes_equal(l, r);
+    }
+  };
+
+  // Transparent order, e.g. `std::map<Bytes, V, BytesLess>::find(BytesIn)`.
+  struct BytesLess {
+    using is_transparent = void;
+
+    bool operator()(BytesIn l, BytesIn r) const {
+      return bytes_compare(l, r) < 0;
+    }
+    template <size_t N>
+    bool operator()(const BytesN<N> &l, const BytesN<N> &r) const {
+      return bytes_compare(l, r) < 0;
+    }
+  };
+}  // namespace qtils
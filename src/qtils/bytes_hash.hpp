@@ -0,0 +1,55 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+
+#include <qtils/bytes.hpp>
+#include <qtils/bytes_compare.hpp>
+#include <qtils/bytestr.hpp>
+
+namespace qtils {
+  /**
+   * Transparent hash for `Bytes`, `BytesN`, `BytesIn` and `BytesOut`,
+   * equal content gives equal hash regardless of type.
+   * With `BytesEqual` allows `find(BytesIn)` on map keyed by `Bytes`.
+   */
+  struct BytesHash {
+    using is_transparent = void;
+
+    size_t operator()(BytesIn bytes) const {
+      return std::hash<std::string_view>{}(byte2str(bytes));
+    }
+  };
+
+  /**
+   * Transparent hash which takes first 8 bytes as is, for uniformly random
+   * keys like block hashes and public keys.
+   * Don't use on attacker-chosen keys.
+   */
+  struct RandomBytesHash {
+    using is_transparent = void;
+
+    size_t operator()(BytesIn bytes) const {
+      if (bytes.size() < sizeof(size_t)) {
+        return BytesHash{}(bytes);
+      }
+      size_t hash;
+      memcpy(&hash, bytes.data(), sizeof(hash));
+      return hash;
+    }
+
+    template <size_t N>
+      requires(N >= sizeof(size_t))
+    size_t operator()(const BytesN<N> &bytes) const {
+      size_t hash;
+      memcpy(&hash, bytes.data(), sizeof(hash));
+      return hash;
+    }
+  };
+}  // namespace qtils
@@ -0,0 +1,413 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <qtils/bytes.hpp>
+#include <qtils/bytes_hash.hpp>
+#include <qtils/hex.hpp>
+
+namespace qtils {
+  /**
+   * Process-wide pool of byte buffers in power-of-two size classes
+   * (256 B to 4 MiB), larger buffers are not pooled.
+   * Released buffer goes to calling thread cache (classes up to 64 KiB,
+   * few per class), then to lock-free global slots while global retained
+   * bytes are under cap, otherwise back to allocator.
+   */
+  class BytesPool {
+   public:
+    static constexpr size_t kMinClassBits = 8;
+    static constexpr size_t kMaxClassBits = 22;
+    static constexpr size_t kMaxThreadClassBits = 16;
+    static constexpr size_t kClasses = kMaxClassBits - kMinClassBits + 1;
+    static constexpr size_t kThreadCacheCount = 4;
+    static constexpr size_t kGlobalSlots = 64;
+    static constexpr size_t kDefaultMaxRetained = 256 << 20;
+
+    struct Stats {
+      // Acquired from thread cache or global slots.
+      size_t hits = 0;
+      // Allocated, including sizes above largest class.
+      size_t misses = 0;
+      // Held by pool, including thread caches.
+      size_t retained = 0;
+    };
+
+    // Never destroyed, so thread caches may flush on late thread exit.
+    static BytesPool &instance() {
+      static auto pool = new BytesPool;
+      return *pool;
+    }
+
+    BytesPool(const BytesPool &) = delete;
+    BytesPool &operator=(const BytesPool &) = delete;
+
+    // Cap for global slots, thread caches are bounded separately.
+    void set_max_retained(size_t bytes) {
+      max_retained_.store(bytes, std::memory_order_relaxed);
+    }
+    size_t max_retained() const {
+      return max_retained_.load(std::memory_order_relaxed);
+    }
+
+    Stats stats() const {
+      std::lock_guard lock{registry_mutex_};
+      auto stats = retired_;
+      stats.retained = retained_.load(std::memory_order_relaxed);
+      for (auto cache : caches_) {
+        stats.hits += cache->hits.load(std::memory_order_relaxed);
+        stats.misses += cache->misses.load(std::memory_order_relaxed);
+        stats.retained += cache->retained.load(std::memory_order_relaxed);
+      }
+      return stats;
+    }
+
+    // Returns uninitialized block of at least `size` bytes and its capacity.
+    std::pair<uint8_t *, size_t> acquire(size_t size) {
+      auto cache = thread_cache();
+      if (size > kMaxClass) {
+        miss(cache);
+        return {new uint8_t[size], size};
+      }
+      auto c = size_class(size);
+      auto capacity = class_capacity(c);
+      if (cache != nullptr and cache->counts[c] != 0) {
+        increment(cache->hits);
+        add(cache->retained, -capacity);
+        return {cache->blocks[c][--cache->counts[c]], capacity};
+      }
+      for (auto &slot : slots_[c]) {
+        if (slot.load(std::memory_order_relaxed) == nullptr) {
+          continue;
+        }
+        if (auto block = slot.exchange(nullptr, std::memory_order_acquire)) {
+          retained_.fetch_sub(capacity, std::memory_order_relaxed);
+          hit(cache);
+          return {block, capacity};
+        }
+      }
+      miss(cache);
+      return {new uint8_t[capacity], capacity};
+    }
+
+    // Takes block returned by `acquire`.
+    void release(uint8_t *block, size_t capacity) {
+      if (capacity > kMaxClass) {
+        delete[] block;
+        return;
+      }
+      auto c = size_class(capacity);
+      auto cache = thread_cache();
+      if (cache != nullptr and capacity <= kMaxThreadClass
+          and cache->counts[c] < kThreadCacheCount) {
+        cache->blocks[c][cache->counts[c]++] = block;
+        add(cache->retained, capacity);
+        return;
+      }
+      release_global(block, c);
+    }
+
+    // Frees blocks in global slots, thread caches are kept.
+    void trim() {
+      for (size_t c = 0; c < kClasses; ++c) {
+        for (auto &slot : slots_[c]) {
+          if (auto block = slot.exchange(nullptr, std::memory_order_acquire)) {
+            retained_.fetch_sub(class_capacity(c), std::memory_order_relaxed);
+            delete[] block;
+          }
+        }
+      }
+    }
+
+   private:
+    static constexpr size_t kMaxClass = size_t{1} << kMaxClassBits;
+    static constexpr size_t kMaxThreadClass = size_t{1} << kMaxThreadClassBits;
+
+    struct ThreadCache {
+      ThreadCache() {
+        instance().attach(*this);
+      }
+      ~ThreadCache() {
+        thread_exited() = true;
+        instance().detach(*this);
+      }
+
+      uint8_t *blocks[kClasses][kThreadCacheCount];
+      size_t counts[kClasses] = {};
+      // Written only by owner thread, read by `stats`.
+      std::atomic<size_t> hits = 0;
+      std::atomic<size_t> misses = 0;
+      std::atomic<size_t> retained = 0;
+    };
+
+    BytesPool() = default;
+
+    static size_t size_class(size_t size) {
+      return std::bit_width(std::max(size, size_t{1} << kMinClassBits) - 1)
+           - kMinClassBits;
+    }
+    static size_t class_capacity(size_t c) {
+      return size_t{1} << (c + kMinClassBits);
+    }
+
+    // Owner-only update without locked instruction.
+    static void add(std::atomic<size_t> &counter, size_t delta) {
+      counter.store(counter.load(std::memory_order_relaxed) + delta,
+          std::memory_order_relaxed);
+    }
+    static void increment(std::atomic<size_t> &counter) {
+      add(counter, 1);
+    }
+
+    /**
+     * Set once calling thread cache is destroyed. Constant-initialized and
+     * trivially destructible, so stays valid for thread_local and static
+     * `PooledBytes` destroyed after the cache.
+     */
+    static bool &thread_exited() {
+      thread_local bool exited = false;
+      return exited;
+    }
+
+    // Null after thread cache is destroyed, callers use global slots.
+    static ThreadCache *thread_cache() {
+      if (thread_exited()) {
+        return nullptr;
+      }
+      thread_local ThreadCache cache;
+      return &cache;
+    }
+
+    void hit(ThreadCache *cache) {
+      if (cache != nullptr) {
+        increment(cache->hits);
+        return;
+      }
+      std::lock_guard lock{registry_mutex_};
+      ++retired_.hits;
+    }
+    void miss(ThreadCache *cache) {
+      if (cache != nullptr) {
+        increment(cache->misses);
+        return;
+      }
+      std::lock_guard lock{registry_mutex_};
+      ++retired_.misses;
+    }
+
+    void release_global(uint8_t *block, size_t c) {
+      auto capacity = class_capacity(c);
+      if (retained_.fetch_add(capacity, std::memory_order_relaxed) + capacity
+          <= max_retained()) {
+        for (auto &slot : slots_[c]) {
+          uint8_t *empty = nullptr;
+          if (slot.load(std::memory_order_relaxed) == nullptr
+              and slot.compare_exchange_strong(
+                  empty, block, std::memory_order_release)) {
+            return;
+          }
+        }
+      }
+      retained_.fetch_sub(capacity, std::memory_order_relaxed);
+      delete[] block;
+    }
+
+    void attach(ThreadCache &cache) {
+      std::lock_guard lock{registry_mutex_};
+      caches_.emplace_back(&cache);
+    }
+
+    // Flushes exiting thread cache to global slots.
+    void detach(ThreadCache &cache) {
+      for (size_t c = 0; c < kClasses; ++c) {
+        for (size_t i = 0; i < cache.counts[c]; ++i) {
+          release_global(cache.blocks[c][i], c);
+        }
+      }
+      std::lock_guard lock{registry_mutex_};
+      std::erase(caches_, &cache);
+      retired_.hits += cache.hits.load(std::memory_order_relaxed);
+      retired_.misses += cache.misses.load(std::memory_order_relaxed);
+    }
+
+    std::atomic<uint8_t *> slots_[kClasses][kGlobalSlots] = {};
+    std::atomic<size_t> retained_ = 0;
+    std::atomic<size_t> max_retained_ = kDefaultMaxRetained;
+
+    mutable std::mutex registry_mutex_;
+    std::vector<ThreadCache *> caches_;
+    Stats retired_;
+  };
+
+  /**
+   * `Bytes`-like buffer which storage comes from and returns to
+   * `BytesPool::instance()`.
+   * Capacity is rounded up to pool size class.
+   */
+  class PooledBytes {
+   public:
+    using value_type = uint8_t;
+    using size_type = size_t;
+    using iterator = uint8_t *;
+    using const_iterator = const uint8_t *;
+
+    PooledBytes() = default;
+
+    explicit PooledBytes(size_t size) {
+      resize(size);
+    }
+
+    explicit PooledBytes(BytesIn bytes) {
+      assign(bytes);
+    }
+
+    PooledBytes(const PooledBytes &other) {
+      assign(other);
+    }
+
+    PooledBytes(PooledBytes &&other) noexcept
+        : data_{std::exchange(other.data_, nullptr)},
+          size_{std::exchange(other.size_, 0)},
+          capacity_{std::exchange(other.capacity_, 0)} {}
+
+    PooledBytes &operator=(const PooledBytes &other) {
+      if (this != &other) {
+        assign(other);
+      }
+      return *this;
+    }
+
+    PooledBytes &operator=(PooledBytes &&other) noexcept {
+      if (this != &other) {
+        free();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+      }
+      return *this;
+    }
+
+    ~PooledBytes() {
+      free();
+    }
+
+    uint8_t *data() {
+      return data_;
+    }
+    const uint8_t *data() const {
+      return data_;
+    }
+    size_t size() const {
+      return size_;
+    }
+    size_t capacity() const {
+      return capacity_;
+    }
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    iterator begin() {
+      return data_;
+    }
+    iterator end() {
+      return data_ + size_;
+    }
+    const_iterator begin() const {
+      return data_;
+    }
+    const_iterator end() const {
+      return data_ + size_;
+    }
+
+    uint8_t &operator[](size_t i) {
+      return data_[i];
+    }
+    uint8_t operator[](size_t i) const {
+      return data_[i];
+    }
+
+    void reserve(size_t capacity) {
+      if (capacity <= capacity_) {
+        return;
+      }
+      auto [data, acquired] = BytesPool::instance().acquire(
+          std::max(capacity, 2 * capacity_));
+      if (size_ != 0) {
+        memcpy(data, data_, size_);
+      }
+      free();
+      data_ = data;
+      capacity_ = acquired;
+    }
+
+    void resize(size_t size) {
+      reserve(size);
+      if (size > size_) {
+        memset(data_ + size_, 0, size - size_);
+      }
+      size_ = size;
+    }
+
+    // Leaves new bytes uninitialized.
+    void resize_uninitialized(size_t size) {
+      reserve(size);
+      size_ = size;
+    }
+
+    void push_back(uint8_t byte) {
+      reserve(size_ + 1);
+      data_[size_++] = byte;
+    }
+
+    void clear() {
+      size_ = 0;
+    }
+
+    void assign(BytesIn bytes) {
+      size_ = 0;
+      reserve(bytes.size());
+      if (not bytes.empty()) {
+        memcpy(data_, bytes.data(), bytes.size());
+      }
+      size_ = bytes.size();
+    }
+
+    bool operator==(const PooledBytes &other) const {
+      return std::ranges::equal(*this, other);
+    }
+    auto operator<=>(const PooledBytes &other) const {
+      return std::lexicographical_compare_three_way(
+          begin(), end(), other.begin(), other.end());
+    }
+
+   private:
+    void free() {
+      if (data_ != nullptr) {
+        BytesPool::instance().release(data_, capacity_);
+      }
+    }
+
+    uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+  };
+}  // namespace qtils
+
+template <>
+struct fmt::formatter<qtils::PooledBytes> : fmt::formatter<qtils::BytesIn> {};
+
+template <>
+struct std::hash<qtils::PooledBytes> : qtils::BytesHash {};
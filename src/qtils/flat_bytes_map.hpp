@@ -0,0 +1,529 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#include <qtils/bytes.hpp>
+#include <qtils/bytes_compare.hpp>
+#include <qtils/bytes_hash.hpp>
+
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
+namespace qtils::detail {
+  /**
+   * Control byte per slot: empty, deleted or 7 low bits of key hash.
+   * Group of 16 control bytes is probed at once.
+   */
+  using Ctrl = int8_t;
+  constexpr Ctrl kCtrlEmpty = -128;
+  constexpr Ctrl kCtrlDeleted = -2;
+  constexpr size_t kCtrlGroup = 16;
+
+  class CtrlGroup {
+   public:
+    explicit CtrlGroup(const Ctrl *ctrl) {
+#ifdef __SSE2__
+      ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+      memcpy(ctrl_, ctrl, kCtrlGroup);
+#endif
+    }
+
+    // Bit per slot with hash `h2`.
+    uint32_t match(Ctrl h2) const {
+#ifdef __SSE2__
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h2)));
+#else
+      return match([&](Ctrl c) { return c == h2; });
+#endif
+    }
+
+    uint32_t match_empty() const {
+      return match(kCtrlEmpty);
+    }
+
+    uint32_t match_empty_or_deleted() const {
+#ifdef __SSE2__
+      return _mm_movemask_epi8(ctrl_);
+#else
+      return match([](Ctrl c) { return c < 0; });
+#endif
+    }
+
+   private:
+#ifdef __SSE2__
+    __m128i ctrl_;
+#else
+    template <typename F>
+    uint32_t match(const F &f) const {
+      uint32_t mask = 0;
+      for (size_t i = 0; i < kCtrlGroup; ++i) {
+        mask |= uint32_t{f(ctrl_[i])} << i;
+      }
+      return mask;
+    }
+
+    Ctrl ctrl_[kCtrlGroup];
+#endif
+  };
+}  // namespace qtils::detail
+
+namespace qtils {
+  /**
+   * Open-addressing (swiss table) hash map with `BytesN<N>` keys.
+   * Control bytes and slots live in one allocation, no node per entry.
+   * `V = void` makes set, see `FlatBytesSet`.
+   * Default `RandomBytesHash` suits hash-like keys.
+   * Iterators and references are invalidated by insert and rehash.
+   */
+  template <size_t N, typename V, typename Hash = RandomBytesHash>
+  class FlatBytesMap {
+    static constexpr bool kSet = std::is_void_v<V>;
+
+   public:
+    using key_type = BytesN<N>;
+    using mapped_type = V;
+    using slot_type = std::
+        conditional_t<kSet, key_type, std::pair<const key_type, mapped_type>>;
+    using value_type = std::conditional_t<kSet, const key_type, slot_type>;
+    using size_type = size_t;
+
+    template <bool kConst>
+    class Iterator {
+     public:
+      using value_type = FlatBytesMap::value_type;
+      using difference_type = ptrdiff_t;
+      using iterator_category = std::forward_iterator_tag;
+      using pointer =
+          std::conditional_t<kConst, const value_type *, value_type *>;
+      using reference = std::remove_pointer_t<pointer> &;
+
+      Iterator() = default;
+
+      operator Iterator<true>() const
+        requires(not kConst)
+      {
+        return {ctrl_, slot_, end_};
+      }
+
+      reference operator*() const {
+        return *slot_;
+      }
+      pointer operator->() const {
+        return slot_;
+      }
+
+      Iterator &operator++() {
+        ++ctrl_;
+        ++slot_;
+        skip();
+        return *this;
+      }
+      Iterator operator++(int) {
+        auto it = *this;
+        ++*this;
+        return it;
+      }
+
+      bool operator==(const Iterator &other) const {
+        return ctrl_ == other.ctrl_;
+      }
+
+     private:
+      friend FlatBytesMap;
+      friend Iterator<not kConst>;
+
+      Iterator(const detail::Ctrl *ctrl, pointer slot, const detail::Ctrl *end)
+          : ctrl_{ctrl}, slot_{slot}, end_{end} {}
+
+      void skip() {
+        while (ctrl_ != end_ and *ctrl_ < 0) {
+          ++ctrl_;
+          ++slot_;
+        }
+      }
+
+      const detail::Ctrl *ctrl_ = nullptr;
+      pointer slot_ = nullptr;
+      const detail::Ctrl *end_ = nullptr;
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatBytesMap() = default;
+
+    explicit FlatBytesMap(size_t capacity) {
+      reserve(capacity);
+    }
+
+    FlatBytesMap(const FlatBytesMap &other) : hash_{other.hash_} {
+      if (other.capacity_ == 0) {
+        return;
+      }
+      allocate(other.capacity_);
+      // Tombstones are copied too, they keep probe sequences intact.
+      for (size_t i = 0; i < capacity_; ++i) {
+        if (other.ctrl_[i] >= 0) {
+          ::new (slots_ + i) slot_type(other.slots_[i]);
+        }
+      }
+      memcpy(ctrl_, other.ctrl_, capacity_ + detail::kCtrlGroup);
+      size_ = other.size_;
+      deleted_ = other.deleted_;
+    }
+
+    FlatBytesMap(FlatBytesMap &&other) noexcept
+        : ctrl_{std::exchange(other.ctrl_, nullptr)},
+          slots_{std::exchange(other.slots_, nullptr)},
+          capacity_{std::exchange(other.capacity_, 0)},
+          size_{std::exchange(other.size_, 0)},
+          deleted_{std::exchange(other.deleted_, 0)},
+          hash_{other.hash_} {}
+
+    FlatBytesMap &operator=(FlatBytesMap other) noexcept {
+      swap(other);
+      return *this;
+    }
+
+    ~FlatBytesMap() {
+      destroy();
+      deallocate();
+    }
+
+    void swap(FlatBytesMap &other) noexcept {
+      std::swap(ctrl_, other.ctrl_);
+      std::swap(slots_, other.slots_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(size_, other.size_);
+      std::swap(deleted_, other.deleted_);
+      std::swap(hash_, other.hash_);
+    }
+
+    size_t size() const {
+      return size_;
+    }
+    bool empty() const {
+      return size_ == 0;
+    }
+    // Number of slots.
+    size_t capacity() const {
+      return capacity_;
+    }
+
+    iterator begin() {
+      return iterator_at<false>(0);
+    }
+    iterator end() {
+      return iterator_at<false>(capacity_);
+    }
+    const_iterator begin() const {
+      return iterator_at<true>(0);
+    }
+    const_iterator end() const {
+      return iterator_at<true>(capacity_);
+    }
+
+    iterator find(const key_type &key) {
+      return iterator_at<false>(find_index(key));
+    }
+    const_iterator find(const key_type &key) const {
+      return iterator_at<true>(find_index(key));
+    }
+    iterator find(BytesIn key) {
+      return key.size() == N ? find(as_key(key)) : end();
+    }
+    const_iterator find(BytesIn key) const {
+      return key.size() == N ? find(as_key(key)) : end();
+    }
+
+    bool contains(const key_type &key) const {
+      return find_index(key) != capacity_;
+    }
+    bool contains(BytesIn key) const {
+      return key.size() == N and contains(as_key(key));
+    }
+
+    template <typename... Args>
+      requires(not kSet)
+    std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+      return emplace_key(key, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+      requires(not kSet)
+    std::pair<iterator, bool> insert_or_assign(const key_type &key, T &&value) {
+      auto r = emplace_key(key, std::forward<T>(value));
+      if (not r.second) {
+        r.first->second = std::forward<T>(value);
+      }
+      return r;
+    }
+
+    template <typename T = V>
+      requires(not kSet)
+    T &operator[](const key_type &key) {
+      return emplace_key(key).first->second;
+    }
+
+    std::pair<iterator, bool> insert(const key_type &key)
+      requires kSet
+    {
+      return emplace_key(key);
+    }
+
+    size_t erase(const key_type &key) {
+      auto i = find_index(key);
+      if (i == capacity_) {
+        return 0;
+      }
+      erase_at(i);
+      return 1;
+    }
+
+    // Returns iterator following erased element.
+    iterator erase(const_iterator it) {
+      auto i = static_cast<size_t>(it.ctrl_ - ctrl_);
+      erase_at(i);
+      return iterator_at<false>(i + 1);
+    }
+
+    void clear() {
+      destroy();
+      if (capacity_ != 0) {
+        memset(ctrl_, detail::kCtrlEmpty, capacity_ + detail::kCtrlGroup);
+      }
+      size_ = 0;
+      deleted_ = 0;
+    }
+
+    /**
+     * Makes room for `count` elements in total without rehash.
+     * Inserts may not reuse tombstones, so they count as used, and are
+     * dropped when they don't leave enough room.
+     */
+    void reserve(size_t count) {
+      if (count > size_ and count + deleted_ > max_load(capacity_)) {
+        resize(std::max(capacity_, capacity_for(count)));
+      }
+    }
+
+    // Rebuilds with at least `count` slots, dropping tombstones.
+    void rehash(size_t count) {
+      auto capacity = std::bit_ceil(std::max(count, detail::kCtrlGroup));
+      resize(std::max(capacity, capacity_for(size_)));
+    }
+
+   private:
+    static constexpr size_t kAlign =
+        std::max(alignof(slot_type), detail::kCtrlGroup);
+
+    // Up to 7/8 of slots may be used, including tombstones.
+    static size_t max_load(size_t capacity) {
+      return capacity - capacity / 8;
+    }
+
+    static size_t capacity_for(size_t count) {
+      size_t capacity = detail::kCtrlGroup;
+      while (max_load(capacity) < count) {
+        capacity *= 2;
+      }
+      return capacity;
+    }
+
+    static size_t slots_offset(size_t capacity) {
+      auto size = capacity + detail::kCtrlGroup;
+      return (size + alignof(slot_type) - 1) / alignof(slot_type)
+           * alignof(slot_type);
+    }
+
+    static const key_type &key_of(const slot_type &slot) {
+      if constexpr (kSet) {
+        return slot;
+      } else {
+        return slot.first;
+      }
+    }
+
+    static key_type as_key(BytesIn bytes) {
+      key_type key;
+      memcpy(key.data(), bytes.data(), N);
+      return key;
+    }
+
+    static detail::Ctrl h2(size_t hash) {
+      return static_cast<detail::Ctrl>(hash & 0x7f);
+    }
+
+    template <bool kConst>
+    Iterator<kConst> iterator_at(size_t i) const {
+      Iterator<kConst> it{ctrl_ + i, slots_ + i, ctrl_ + capacity_};
+      it.skip();
+      return it;
+    }
+
+    // Calls `f(i)` for slots on probe sequence of `hash` until it returns true.
+    template <typename F>
+    void probe(size_t hash, const F &f) const {
+      auto mask = capacity_ - 1;
+      auto pos = (hash >> 7) & mask;
+      for (size_t step = detail::kCtrlGroup;; step += detail::kCtrlGroup) {
+        if (f(pos, detail::CtrlGroup{ctrl_ + pos})) {
+          return;
+        }
+        pos = (pos + step) & mask;
+      }
+    }
+
+    // Returns `capacity_` when missing.
+    size_t find_index(const key_type &key) const {
+      if (capacity_ == 0) {
+        return 0;
+      }
+      auto hash = hash_(key);
+      auto found = capacity_;
+      probe(hash, [&](size_t pos, const detail::CtrlGroup &group) {
+        for (auto m = group.match(h2(hash)); m != 0; m &= m - 1) {
+          auto i = (pos + std::countr_zero(m)) & (capacity_ - 1);
+          if (bytes_equal(key_of(slots_[i]), key)) {
+            found = i;
+            return true;
+          }
+        }
+        return group.match_empty() != 0;
+      });
+      return found;
+    }
+
+    size_t find_free(size_t hash) const {
+      size_t found = 0;
+      probe(hash, [&](size_t pos, const detail::CtrlGroup &group) {
+        auto m = group.match_empty_or_deleted();
+        if (m == 0) {
+          return false;
+        }
+        found = (pos + std::countr_zero(m)) & (capacity_ - 1);
+        return true;
+      });
+      return found;
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace_key(const key_type &key, Args &&...args) {
+      auto i = find_index(key);
+      if (i != capacity_) {
+        return {iterator_at<false>(i), false};
+      }
+      if (size_ + deleted_ + 1 > max_load(capacity_)) {
+        // Drop tombstones in place when at most half full.
+        resize(capacity_ != 0 and size_ + 1 <= max_load(capacity_) / 2
+                   ? capacity_
+                   : capacity_for(size_ + 1));
+      }
+      auto hash = hash_(key);
+      i = find_free(hash);
+      if (ctrl_[i] == detail::kCtrlDeleted) {
+        --deleted_;
+      }
+      if constexpr (kSet) {
+        ::new (slots_ + i) slot_type(key);
+      } else {
+        ::new (slots_ + i) slot_type(std::piecewise_construct,
+            std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+      }
+      set_ctrl(i, h2(hash));
+      ++size_;
+      return {iterator_at<false>(i), true};
+    }
+
+    void erase_at(size_t i) {
+      slots_[i].~slot_type();
+      set_ctrl(i, detail::kCtrlDeleted);
+      --size_;
+      ++deleted_;
+    }
+
+    // Last group mirrors first, so probe never wraps inside group.
+    void set_ctrl(size_t i, detail::Ctrl ctrl) {
+      ctrl_[i] = ctrl;
+      if (i < detail::kCtrlGroup) {
+        ctrl_[capacity_ + i] = ctrl;
+      }
+    }
+
+    void allocate(size_t capacity) {
+      auto memory = static_cast<uint8_t *>(::operator new(
+          slots_offset(capacity) + capacity * sizeof(slot_type),
+          std::align_val_t{kAlign}));
+      ctrl_ = reinterpret_cast<detail::Ctrl *>(memory);
+      slots_ = reinterpret_cast<slot_type *>(memory + slots_offset(capacity));
+      capacity_ = capacity;
+      memset(ctrl_, detail::kCtrlEmpty, capacity + detail::kCtrlGroup);
+    }
+
+    void deallocate() {
+      if (ctrl_ != nullptr) {
+        ::operator delete(ctrl_, std::align_val_t{kAlign});
+      }
+    }
+
+    void destroy() {
+      if constexpr (not std::is_trivially_destructible_v<slot_type>) {
+        for (size_t i = 0; i < capacity_; ++i) {
+          if (ctrl_[i] >= 0) {
+            slots_[i].~slot_type();
+          }
+        }
+      }
+    }
+
+    void resize(size_t capacity) {
+      auto old_ctrl = ctrl_;
+      auto old_slots = slots_;
+      auto old_capacity = capacity_;
+      allocate(capacity);
+      deleted_ = 0;
+      for (size_t j = 0; j < old_capacity; ++j) {
+        if (old_ctrl[j] < 0) {
+          continue;
+        }
+        auto &old = old_slots[j];
+        auto hash = hash_(key_of(old));
+        auto i = find_free(hash);
+        if constexpr (kSet) {
+          ::new (slots_ + i) slot_type(old);
+        } else {
+          ::new (slots_ + i) slot_type(old.first, std::move(old.second));
+        }
+        set_ctrl(i, h2(hash));
+        old.~slot_type();
+      }
+      if (old_ctrl != nullptr) {
+        ::operator delete(old_ctrl, std::align_val_t{kAlign});
+      }
+    }
+
+    detail::Ctrl *ctrl_ = nullptr;
+    slot_type *slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    size_t deleted_ = 0;
+    [[no_unique_address]] Hash hash_;
+  };
+
+  template <size_t N, typename Hash = RandomBytesHash>
+  using FlatBytesSet = FlatBytesMap<N, void, Hash>;
+}  // namespace qtils
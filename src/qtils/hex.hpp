@@ -6,9 +6,39 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <fmt/format.h>
+#include <string>
 
 #include <qtils/bytes.hpp>
+#include <qtils/hex_kernel.hpp>
+
+namespace qtils {
+  /**
+   * Writes `2 * bytes.size()` chars to front of `out`.
+   * Precondition: `out.size() >= 2 * bytes.size()`.
+   */
+  inline std::string_view hex_to(std::span<char> out, BytesIn bytes) {
+    assert(out.size() >= 2 * bytes.size());
+    hex_kernel::encode(out.data(), bytes.data(), bytes.size(), true);
+    return {out.data(), 2 * bytes.size()};
+  }
+
+  inline std::string hex(BytesIn bytes) {
+    std::string s(2 * bytes.size(), '\0');
+    hex_to(s, bytes);
+    return s;
+  }
+
+  inline std::string hex0x(BytesIn bytes) {
+    std::string s(2 + 2 * bytes.size(), '\0');
+    s[0] = '0';
+    s[1] = 'x';
+    hex_to(std::span{s}.subspan(2), bytes);
+    return s;
+  }
+}  // namespace qtils
 
 template <>
 struct fmt::formatter<qtils::BytesIn> {
@@ -42,20 +72,71 @@ struct fmt::formatter<qtils::BytesIn> {
     if (prefix) {
       out = fmt::detail::write(out, "0x");
     }
-    constexpr size_t kHead = 2, kTail = 2, kSmall = 1;
     if (full or bytes.size() <= kHead + kTail + kSmall) {
-      return lower ? fmt::format_to(out, "{:02x}", fmt::join(bytes, ""))
-                   : fmt::format_to(out, "{:02X}", fmt::join(bytes, ""));
+      return write_full(out, bytes);
     }
     return fmt::format_to(out,
         "{:02x}…{:02x}",
         fmt::join(bytes.first(kHead), ""),
         fmt::join(bytes.last(kTail), ""));
   }
+
+ protected:
+  static constexpr size_t kHead = 2, kTail = 2, kSmall = 1;
+
+  format_context::iterator write_full(
+      format_context::iterator out, qtils::BytesIn bytes) const {
+    auto size = 2 * bytes.size();
+    out = fmt::detail::reserve<char>(out, size);
+    if (auto ptr = fmt::detail::to_pointer<char>(out, size)) {
+      qtils::hex_kernel::encode(ptr, bytes.data(), bytes.size(), lower);
+      return out;
+    }
+    constexpr size_t kChunk = 512;
+    char chunk[2 * kChunk];
+    while (not bytes.empty()) {
+      auto n = std::min(bytes.size(), kChunk);
+      qtils::hex_kernel::encode(chunk, bytes.data(), n, lower);
+      out = std::copy_n(chunk, 2 * n, out);
+      bytes = bytes.subspan(n);
+    }
+    return out;
+  }
 };
 template <>
 struct fmt::formatter<qtils::Bytes> : fmt::formatter<qtils::BytesIn> {};
+template <>
+struct fmt::formatter<qtils::UninitBytes> : fmt::formatter<qtils::BytesIn> {};
+template <>
+struct fmt::formatter<qtils::pmr::Bytes> : fmt::formatter<qtils::BytesIn> {};
 template <size_t N>
-struct fmt::formatter<qtils::BytesN<N>> : fmt::formatter<qtils::BytesIn> {};
+struct fmt::formatter<qtils::BytesN<N>> : fmt::formatter<qtils::BytesIn> {
+  auto format(const qtils::BytesN<N> &bytes, format_context &ctx) const {
+    using qtils::hex_kernel::encode_unrolled;
+    std::array<char, 2 + 2 * N> buffer;
+    auto out = buffer.data();
+    if (prefix) {
+      out = std::copy_n("0x", 2, out);
+    }
+    if (full or N <= kHead + kTail + kSmall) {
+      if constexpr (N <= kMaxUnrolled) {
+        out = encode_unrolled<N>(out, bytes.data(), lower);
+      } else {
+        qtils::hex_kernel::encode(out, bytes.data(), N, lower);
+        out += 2 * N;
+      }
+    } else {
+      out = encode_unrolled<kHead>(out, bytes.data(), true);
+      out = std::copy_n("…", std::char_traits<char>::length("…"), out);
+      out = encode_unrolled<kTail>(out, bytes.data() + N - kTail, true);
+    }
+    size_t size = out - buffer.data();
+    return fmt::detail::write<char>(
+        ctx.out(), fmt::string_view{buffer.data(), size});
+  }
+
+ private:
+  static constexpr size_t kMaxUnrolled = 64;
+};
 template <>
 struct fmt::formatter<qtils::BytesOut> : fmt::formatter<qtils::BytesIn> {};
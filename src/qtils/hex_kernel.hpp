@@ -0,0 +1,320 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <qtils/simd_level.hpp>
+
+#ifdef QTILS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace qtils::hex_kernel {
+  using HexPairs = std::array<std::array<char, 2>, 256>;
+
+  inline constexpr char kLowerDigits[] = "0123456789abcdef";
+  inline constexpr char kUpperDigits[] = "0123456789ABCDEF";
+
+  consteval HexPairs make_hex_pairs(const char (&digits)[17]) {
+    HexPairs pairs{};
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      pairs[i] = {digits[i >> 4], digits[i & 0xf]};
+    }
+    return pairs;
+  }
+
+  inline constexpr HexPairs kLowerPairs = make_hex_pairs(kLowerDigits);
+  inline constexpr HexPairs kUpperPairs = make_hex_pairs(kUpperDigits);
+
+  // Writes `2 * n` chars to `out`.
+  inline void encode_scalar(
+      char *out, const uint8_t *in, size_t n, bool lower) {
+    auto &pairs = lower ? kLowerPairs : kUpperPairs;
+    for (size_t i = 0; i < n; ++i) {
+      auto &pair = pairs[in[i]];
+      out[2 * i] = pair[0];
+      out[2 * i + 1] = pair[1];
+    }
+  }
+
+  // Writes `2 * N` chars to `out`, returns end of written chars.
+  template <size_t N>
+  char *encode_unrolled(char *out, const uint8_t *in, bool lower) {
+    auto &pairs = lower ? kLowerPairs : kUpperPairs;
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      ((out[2 * I] = pairs[in[I]][0], out[2 * I + 1] = pairs[in[I]][1]), ...);
+    }(std::make_index_sequence<N>());
+    return out + 2 * N;
+  }
+
+  // Nibble value of hex digit or `kNonHex`.
+  inline constexpr uint8_t kNonHex = 0xff;
+
+  consteval std::array<uint8_t, 256> make_nibbles() {
+    std::array<uint8_t, 256> nibbles{};
+    for (size_t i = 0; i < nibbles.size(); ++i) {
+      nibbles[i] = kNonHex;
+    }
+    for (uint8_t i = 0; i < 16; ++i) {
+      nibbles[kLowerDigits[i]] = i;
+      nibbles[kUpperDigits[i]] = i;
+    }
+    return nibbles;
+  }
+
+  inline constexpr std::array<uint8_t, 256> kNibbles = make_nibbles();
+
+  // Decodes `2 * n` chars to `n` bytes, returns false on non-hex char.
+  // Each step reads input before writing output, so `out` may alias `in`.
+  constexpr bool decode_scalar(uint8_t *out, const char *in, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      auto hi = kNibbles[static_cast<uint8_t>(in[2 * i])];
+      auto lo = kNibbles[static_cast<uint8_t>(in[2 * i + 1])];
+      if ((hi | lo) == kNonHex) {
+        return false;
+      }
+      out[i] = (hi << 4) | lo;
+    }
+    return true;
+  }
+
+  // Vector kernels process whole blocks and return number of bytes done,
+  // the rest is left to scalar kernels.
+  // Decoders stop before block with non-hex char.
+
+#ifdef QTILS_SIMD_X86
+  QTILS_SIMD_TARGET("sse4.1")
+  inline __m128i hex_digits_128(bool lower) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+        lower ? kLowerDigits : kUpperDigits));
+  }
+
+  QTILS_SIMD_TARGET("sse4.1")
+  inline size_t encode_sse41(
+      char *out, const uint8_t *in, size_t n, bool lower) {
+    auto digits = hex_digits_128(lower);
+    auto mask = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+      auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+      auto hi = _mm_shuffle_epi8(
+          digits, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+      auto lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, mask));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i),
+          _mm_unpacklo_epi8(hi, lo));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i + 16),
+          _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+  }
+
+  QTILS_SIMD_TARGET("avx2")
+  inline size_t encode_avx2(
+      char *out, const uint8_t *in, size_t n, bool lower) {
+    auto digits = _mm256_broadcastsi128_si256(hex_digits_128(lower));
+    auto mask = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+      auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+      auto hi = _mm256_shuffle_epi8(
+          digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+      auto lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, mask));
+      // unpack works within 128-bit lanes, permute restores byte order
+      auto a = _mm256_unpacklo_epi8(hi, lo);
+      auto b = _mm256_unpackhi_epi8(hi, lo);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i),
+          _mm256_permute2x128_si256(a, b, 0x20));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i + 32),
+          _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return i;
+  }
+
+  QTILS_SIMD_TARGET("avx512f,avx512bw")
+  inline size_t encode_avx512(
+      char *out, const uint8_t *in, size_t n, bool lower) {
+    // maskz forms of intrinsics avoid gcc -Wuninitialized false positives
+    auto digits = _mm512_maskz_broadcast_i32x4(-1, hex_digits_128(lower));
+    auto mask = _mm512_set1_epi8(0x0f);
+    // 64-bit words of unpacked 128-bit lanes in output order
+    auto first = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+    auto second = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+      auto v = _mm512_loadu_si512(in + i);
+      auto hi = _mm512_shuffle_epi8(
+          digits, _mm512_and_si512(_mm512_srli_epi16(v, 4), mask));
+      auto lo = _mm512_shuffle_epi8(digits, _mm512_and_si512(v, mask));
+      auto a = _mm512_unpacklo_epi8(hi, lo);
+      auto b = _mm512_unpackhi_epi8(hi, lo);
+      _mm512_storeu_si512(
+          out + 2 * i, _mm512_permutex2var_epi64(a, first, b));
+      _mm512_storeu_si512(
+          out + 2 * i + 64, _mm512_permutex2var_epi64(a, second, b));
+    }
+    return i;
+  }
+
+  // Nibble values of 16 chars, `valid` lanes are 0xff for hex digits.
+  QTILS_SIMD_TARGET("sse4.1")
+  inline __m128i decode_nibbles_128(__m128i v, __m128i &valid) {
+    auto digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    auto is_digit =
+        _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    auto alpha = _mm_sub_epi8(
+        _mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    auto is_alpha =
+        _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    valid = _mm_or_si128(is_digit, is_alpha);
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+        _mm_and_si128(
+            is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+  }
+
+  QTILS_SIMD_TARGET("sse4.1")
+  inline size_t decode_sse41(uint8_t *out, const char *in, size_t n) {
+    // (hi, lo) byte pairs to `hi * 16 + lo` words
+    auto weights = _mm_set1_epi16(0x0110);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+      auto chars = reinterpret_cast<const __m128i *>(in + 2 * i);
+      __m128i valid1, valid2;
+      auto v1 = decode_nibbles_128(_mm_loadu_si128(chars), valid1);
+      auto v2 = decode_nibbles_128(_mm_loadu_si128(chars + 1), valid2);
+      if (_mm_movemask_epi8(_mm_and_si128(valid1, valid2)) != 0xffff) {
+        break;
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+          _mm_packus_epi16(_mm_maddubs_epi16(v1, weights),
+              _mm_maddubs_epi16(v2, weights)));
+    }
+    return i;
+  }
+
+  QTILS_SIMD_TARGET("avx2")
+  inline __m256i decode_nibbles_256(__m256i v, __m256i &valid) {
+    auto digit = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    auto is_digit =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    auto alpha = _mm256_sub_epi8(
+        _mm256_or_si256(v, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    auto is_alpha =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+    valid = _mm256_or_si256(is_digit, is_alpha);
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+        _mm256_and_si256(
+            is_alpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+  }
+
+  QTILS_SIMD_TARGET("avx2")
+  inline size_t decode_avx2(uint8_t *out, const char *in, size_t n) {
+    auto weights = _mm256_set1_epi16(0x0110);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+      auto chars = reinterpret_cast<const __m256i *>(in + 2 * i);
+      __m256i valid1, valid2;
+      auto v1 = decode_nibbles_256(_mm256_loadu_si256(chars), valid1);
+      auto v2 = decode_nibbles_256(_mm256_loadu_si256(chars + 1), valid2);
+      if (_mm256_movemask_epi8(_mm256_and_si256(valid1, valid2)) != -1) {
+        break;
+      }
+      // pack works within 128-bit lanes, permute restores byte order
+      auto packed = _mm256_packus_epi16(_mm256_maddubs_epi16(v1, weights),
+          _mm256_maddubs_epi16(v2, weights));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+          _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    return i;
+  }
+
+  QTILS_SIMD_TARGET("avx512f,avx512bw")
+  inline __m512i decode_nibbles_512(__m512i v, __mmask64 &valid) {
+    auto digit = _mm512_sub_epi8(v, _mm512_set1_epi8('0'));
+    auto is_digit = _mm512_cmple_epu8_mask(digit, _mm512_set1_epi8(9));
+    auto alpha = _mm512_sub_epi8(
+        _mm512_or_si512(v, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+    auto is_alpha = _mm512_cmple_epu8_mask(alpha, _mm512_set1_epi8(5));
+    valid = is_digit | is_alpha;
+    return _mm512_mask_blend_epi8(
+        is_digit, _mm512_add_epi8(alpha, _mm512_set1_epi8(10)), digit);
+  }
+
+  QTILS_SIMD_TARGET("avx512f,avx512bw")
+  inline size_t decode_avx512(uint8_t *out, const char *in, size_t n) {
+    auto weights = _mm512_set1_epi16(0x0110);
+    // maskz forms of intrinsics avoid gcc -Wuninitialized false positives
+    // 64-bit words of packed 128-bit lanes in output order
+    auto order = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+      __mmask64 valid1, valid2;
+      auto v1 = decode_nibbles_512(_mm512_loadu_si512(in + 2 * i), valid1);
+      auto v2 =
+          decode_nibbles_512(_mm512_loadu_si512(in + 2 * i + 64), valid2);
+      if ((valid1 & valid2) != ~__mmask64{0}) {
+        break;
+      }
+      auto packed = _mm512_packus_epi16(_mm512_maddubs_epi16(v1, weights),
+          _mm512_maddubs_epi16(v2, weights));
+      _mm512_storeu_si512(
+          out + i, _mm512_maskz_permutexvar_epi64(-1, order, packed));
+    }
+    return i;
+  }
+#endif
+
+  struct Kernels {
+    size_t (*encode)(char *out, const uint8_t *in, size_t n, bool lower);
+    size_t (*decode)(uint8_t *out, const char *in, size_t n);
+  };
+
+  inline Kernels select_kernels([[maybe_unused]] SimdLevel level) {
+    Kernels kernels{
+        [](char *, const uint8_t *, size_t, bool) -> size_t { return 0; },
+        [](uint8_t *, const char *, size_t) -> size_t { return 0; },
+    };
+#ifdef QTILS_SIMD_X86
+    switch (level) {
+      case SimdLevel::SCALAR:
+        break;
+      case SimdLevel::SSE41:
+        kernels = {encode_sse41, decode_sse41};
+        break;
+      case SimdLevel::AVX2:
+        kernels = {encode_avx2, decode_avx2};
+        break;
+      case SimdLevel::AVX512:
+        kernels = {encode_avx512, decode_avx512};
+        break;
+    }
+#endif
+    return kernels;
+  }
+
+  // Kernels for `simd_level()`, selected once.
+  inline const Kernels &kernels() {
+    static const Kernels kernels = select_kernels(simd_level());
+    return kernels;
+  }
+
+  // Writes `2 * n` chars to `out`.
+  inline void encode(char *out, const uint8_t *in, size_t n, bool lower) {
+    auto i = kernels().encode(out, in, n, lower);
+    encode_scalar(out + 2 * i, in + i, n - i, lower);
+  }
+
+  // Decodes `2 * n` chars to `n` bytes, returns false on non-hex char.
+  // `out` may alias `in`.
+  inline bool decode(uint8_t *out, const char *in, size_t n) {
+    auto i = kernels().decode(out, in, n);
+    return decode_scalar(out + i, in + 2 * i, n - i);
+  }
+}  // namespace qtils::hex_kernel
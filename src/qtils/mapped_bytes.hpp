@@ -0,0 +1,190 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+#include <qtils/bytes.hpp>
+#include <qtils/outcome.hpp>
+
+namespace qtils {
+  /**
+   * Read-only memory-mapped file (or part of it), paged in lazily.
+   * Unmapped on destruction.
+   * Converts to `BytesIn`.
+   */
+  class MappedBytes {
+   public:
+    enum class Advice {
+      NORMAL,
+      SEQUENTIAL,
+      RANDOM,
+      WILLNEED,
+      DONTNEED,
+      // Linux only, `std::errc::not_supported` elsewhere.
+      HUGEPAGE,
+    };
+
+    MappedBytes() = default;
+
+    MappedBytes(MappedBytes &&other) noexcept
+        : map_{std::exchange(other.map_, nullptr)},
+          map_size_{std::exchange(other.map_size_, 0)},
+          bytes_{std::exchange(other.bytes_, {})} {}
+
+    MappedBytes &operator=(MappedBytes &&other) noexcept {
+      if (this != &other) {
+        unmap();
+        map_ = std::exchange(other.map_, nullptr);
+        map_size_ = std::exchange(other.map_size_, 0);
+        bytes_ = std::exchange(other.bytes_, {});
+      }
+      return *this;
+    }
+
+    MappedBytes(const MappedBytes &) = delete;
+    MappedBytes &operator=(const MappedBytes &) = delete;
+
+    ~MappedBytes() {
+      unmap();
+    }
+
+    // Maps whole file, empty file gives empty view.
+    static Outcome<MappedBytes> open(const std::filesystem::path &path) {
+      return open(path, 0, SIZE_MAX);
+    }
+
+    /**
+     * Maps `size` bytes from `offset`, `size` is clamped to end of file.
+     * `offset` beyond end of file is `std::errc::invalid_argument`.
+     */
+    static Outcome<MappedBytes> open(
+        const std::filesystem::path &path, uint64_t offset, size_t size) {
+      auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd == -1) {
+        return error();
+      }
+      MappedBytes mapped;
+      auto r = mapped.map(fd, offset, size);
+      ::close(fd);
+      if (not r) {
+        return r.error();
+      }
+      return mapped;
+    }
+
+    const uint8_t *data() const {
+      return bytes_.data();
+    }
+    size_t size() const {
+      return bytes_.size();
+    }
+    bool empty() const {
+      return bytes_.empty();
+    }
+    auto begin() const {
+      return bytes_.begin();
+    }
+    auto end() const {
+      return bytes_.end();
+    }
+
+    BytesIn view() const {
+      return bytes_;
+    }
+    operator BytesIn() const {
+      return bytes_;
+    }
+
+    // Hints kernel about access pattern of whole mapping.
+    Outcome<void> advise(Advice advice) const {
+      if (map_ == nullptr) {
+        return outcome::success();
+      }
+      int flag = 0;
+      switch (advice) {
+        case Advice::NORMAL:
+          flag = MADV_NORMAL;
+          break;
+        case Advice::SEQUENTIAL:
+          flag = MADV_SEQUENTIAL;
+          break;
+        case Advice::RANDOM:
+          flag = MADV_RANDOM;
+          break;
+        case Advice::WILLNEED:
+          flag = MADV_WILLNEED;
+          break;
+        case Advice::DONTNEED:
+          flag = MADV_DONTNEED;
+          break;
+        case Advice::HUGEPAGE:
+#ifdef MADV_HUGEPAGE
+          flag = MADV_HUGEPAGE;
+          break;
+#else
+          return std::make_error_code(std::errc::not_supported);
+#endif
+      }
+      if (::madvise(map_, map_size_, flag) != 0) {
+        return error();
+      }
+      return outcome::success();
+    }
+
+   private:
+    static std::error_code error() {
+      return {errno, std::system_category()};
+    }
+
+    Outcome<void> map(int fd, uint64_t offset, size_t size) {
+      struct stat stat;
+      if (::fstat(fd, &stat) != 0) {
+        return error();
+      }
+      uint64_t file_size = stat.st_size;
+      if (offset > file_size) {
+        return std::make_error_code(std::errc::invalid_argument);
+      }
+      size = std::min<uint64_t>(size, file_size - offset);
+      if (size == 0) {
+        return outcome::success();
+      }
+      // `mmap` offset must be page aligned.
+      uint64_t page = ::sysconf(_SC_PAGESIZE);
+      auto shift = offset % page;
+      map_size_ = shift + size;
+      auto map = ::mmap(
+          nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd, offset - shift);
+      if (map == MAP_FAILED) {
+        map_size_ = 0;
+        return error();
+      }
+      map_ = map;
+      bytes_ = {static_cast<const uint8_t *>(map_) + shift, size};
+      return outcome::success();
+    }
+
+    void unmap() {
+      if (map_ != nullptr) {
+        ::munmap(map_, map_size_);
+      }
+    }
+
+    void *map_ = nullptr;
+    size_t map_size_ = 0;
+    BytesIn bytes_;
+  };
+}  // namespace qtils
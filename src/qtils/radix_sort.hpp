@@ -0,0 +1,200 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <ranges>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <qtils/bytes.hpp>
+#include <qtils/bytes_compare.hpp>
+
+namespace qtils::detail {
+  /**
+   * Most-significant-digit radix sort of byte strings.
+   * Each level partitions range by byte at `depth`, skipping bytes shared
+   * by all keys, and recurses into buckets.
+   * Unstable sort swaps in place (american flag sort), stable sort
+   * distributes through scratch buffer.
+   */
+  template <typename It>
+  class RadixSorter {
+   public:
+    RadixSorter(It begin, size_t size, bool stable)
+        : begin_{begin},
+          size_{size},
+          stable_{stable},
+          keys_(size),
+          scratch_(stable ? size : 0) {}
+
+    // Inputs of 64Ki elements or more are split across `threads` threads.
+    void sort(size_t threads) {
+      if (threads > 1 and size_ >= kParallel) {
+        sort_parallel(threads);
+      } else {
+        sort_range(0, size_, 0);
+      }
+    }
+
+   private:
+    // Ranges up to this size are finished with comparison sort.
+    static constexpr size_t kSmall = 64;
+    static constexpr size_t kParallel = size_t{1} << 16;
+    // Bucket 0 holds keys ended before current byte, they sort first.
+    static constexpr size_t kBuckets = 257;
+
+    using Key = uint16_t;
+
+    static Key key(BytesIn bytes, size_t depth) {
+      return depth < bytes.size() ? bytes[depth] + 1 : 0;
+    }
+
+    void sort_range(size_t from, size_t to, size_t depth) {
+      if (to - from <= kSmall) {
+        sort_small(from, to, depth);
+        return;
+      }
+      partition(from, to, depth, [this](size_t from, size_t to, size_t depth) {
+        sort_range(from, to, depth);
+      });
+    }
+
+    // Keys in range share first `depth` bytes.
+    void sort_small(size_t from, size_t to, size_t depth) {
+      auto less = [depth](const auto &l, const auto &r) {
+        BytesIn lb{l}, rb{r};
+        return bytes_compare(lb.subspan(std::min(depth, lb.size())),
+                   rb.subspan(std::min(depth, rb.size())))
+             < 0;
+      };
+      if (stable_) {
+        std::stable_sort(begin_ + from, begin_ + to, less);
+      } else {
+        std::sort(begin_ + from, begin_ + to, less);
+      }
+    }
+
+    // Calls `f(from, to, depth)` for buckets which need further sorting.
+    template <typename F>
+    void partition(size_t from, size_t to, size_t depth, const F &f) {
+      auto keys = keys_.data() + from;
+      auto items = begin_ + from;
+      size_t size = to - from;
+      std::array<size_t, kBuckets> counts;
+      for (;;) {
+        counts.fill(0);
+        for (size_t i = 0; i < size; ++i) {
+          keys[i] = key(items[i], depth);
+          ++counts[keys[i]];
+        }
+        auto single = std::ranges::find(counts, size);
+        if (single == counts.end()) {
+          break;
+        }
+        if (single == counts.begin()) {
+          return;
+        }
+        ++depth;
+      }
+      std::array<size_t, kBuckets> starts, ends;
+      size_t offset = 0;
+      for (size_t b = 0; b < kBuckets; ++b) {
+        starts[b] = offset;
+        offset += counts[b];
+        ends[b] = offset;
+      }
+      auto next = starts;
+      if (stable_) {
+        auto scratch = scratch_.data() + from;
+        for (size_t i = 0; i < size; ++i) {
+          scratch[next[keys[i]]++] = std::move(items[i]);
+        }
+        std::move(scratch, scratch + size, items);
+      } else {
+        for (size_t b = 0; b < kBuckets; ++b) {
+          while (next[b] < ends[b]) {
+            auto i = next[b];
+            auto k = keys[i];
+            if (k == b) {
+              ++next[b];
+            } else {
+              auto j = next[k]++;
+              std::swap(items[i], items[j]);
+              std::swap(keys[i], keys[j]);
+            }
+          }
+        }
+      }
+      for (size_t b = 1; b < kBuckets; ++b) {
+        if (counts[b] > 1) {
+          f(from + starts[b], from + ends[b], depth + 1);
+        }
+      }
+    }
+
+    // Splits by first differing byte, then sorts buckets on threads.
+    void sort_parallel(size_t threads) {
+      std::vector<std::tuple<size_t, size_t, size_t>> tasks;
+      partition(0, size_, 0, [&](size_t from, size_t to, size_t depth) {
+        tasks.emplace_back(from, to, depth);
+      });
+      std::ranges::sort(tasks, std::greater{}, [](auto &task) {
+        return std::get<1>(task) - std::get<0>(task);
+      });
+      std::atomic<size_t> next = 0;
+      auto worker = [&] {
+        for (size_t i; (i = next.fetch_add(1)) < tasks.size();) {
+          auto [from, to, depth] = tasks[i];
+          sort_range(from, to, depth);
+        }
+      };
+      std::vector<std::jthread> pool;
+      for (size_t i = 1; i < std::min(threads, tasks.size()); ++i) {
+        pool.emplace_back(worker);
+      }
+      worker();
+    }
+
+    It begin_;
+    size_t size_;
+    bool stable_;
+    // Byte at current depth of each item, computed once per level.
+    std::vector<Key> keys_;
+    std::vector<std::iter_value_t<It>> scratch_;
+  };
+}  // namespace qtils::detail
+
+namespace qtils {
+  template <typename R>
+  concept RadixSortable = std::ranges::random_access_range<R>
+                      and std::convertible_to<std::ranges::range_value_t<R>,
+                          BytesIn>;
+
+  /**
+   * Sorts byte strings (`BytesN`, `Bytes`, `BytesIn`, ...) lexicographically
+   * by most-significant-digit radix sort, in place.
+   * Inputs of 64Ki elements or more are split across `threads` threads.
+   */
+  template <RadixSortable R>
+  void radix_sort(R &&range, size_t threads = 1) {
+    detail::RadixSorter sorter{
+        std::ranges::begin(range), std::ranges::size(range), false};
+    sorter.sort(threads);
+  }
+
+  // Keeps order of equal keys, uses scratch buffer of range size.
+  template <RadixSortable R>
+  void stable_radix_sort(R &&range, size_t threads = 1) {
+    detail::RadixSorter sorter{
+        std::ranges::begin(range), std::ranges::size(range), true};
+    sorter.sort(threads);
+  }
+}  // namespace qtils
@@ -0,0 +1,940 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <ranges>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <qtils/bytes.hpp>
+#include <qtils/bytes_compare.hpp>
+
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
+namespace qtils {
+  /**
+   * Adaptive radix tree (ART) keyed by byte strings, ordered
+   * lexicographically like `std::map<Bytes, V, BytesLess>`.
+   * Inner nodes hold 4, 16, 48 or 256 children and switch size as children
+   * are added and removed, Node16 is searched with SSE2.
+   * Runs of bytes with single child are compressed into node prefix, and
+   * leaf keeps only key bytes below its parent, so shared key prefixes
+   * (pallet and item hashes of storage keys) are stored once.
+   * `find` and `try_emplace` return value pointers, valid until next erase.
+   * Iterators rebuild key while walking, `*it` is `pair<BytesIn, V &>` by
+   * value, so they are input iterators.
+   * Iterators are invalidated by insert and erase.
+   */
+  template <typename V>
+  class RadixTree {
+    struct Node;
+    struct Leaf;
+
+    // Inner node on iterator path.
+    struct Frame {
+      Node *node;
+      // Next child byte to visit, 256 when done.
+      size_t next;
+      // Key length below node prefix.
+      size_t depth;
+    };
+
+   public:
+    using mapped_type = V;
+    using size_type = size_t;
+
+    template <bool kConst>
+    class Iterator {
+     public:
+      using mapped = std::conditional_t<kConst, const V, V>;
+      using value_type = std::pair<BytesIn, mapped &>;
+      using reference = value_type;
+      using difference_type = ptrdiff_t;
+      // Dereference yields proxy pair by value, so not forward iterator.
+      using iterator_category = std::input_iterator_tag;
+
+      Iterator() = default;
+
+      operator Iterator<true>() const
+        requires(not kConst)
+      {
+        Iterator<true> it;
+        it.stack_ = stack_;
+        it.key_ = key_;
+        it.leaf_ = leaf_;
+        return it;
+      }
+
+      BytesIn key() const {
+        return key_;
+      }
+      mapped &value() const {
+        return leaf_->value;
+      }
+      reference operator*() const {
+        return {key_, leaf_->value};
+      }
+
+      Iterator &operator++() {
+        next();
+        return *this;
+      }
+      Iterator operator++(int) {
+        auto it = *this;
+        ++*this;
+        return it;
+      }
+
+      bool operator==(const Iterator &other) const {
+        return leaf_ == other.leaf_;
+      }
+
+     private:
+      friend RadixTree;
+      friend Iterator<not kConst>;
+
+      // Moves to first key under `ref`, `key_` holds path to `ref`.
+      void descend(Node *ref) {
+        while (not is_leaf(ref)) {
+          auto prefix = prefix_of(ref);
+          key_.insert(key_.end(), prefix.begin(), prefix.end());
+          if (ref->leaf != nullptr) {
+            stack_.push_back({ref, 0, key_.size()});
+            leaf_ = ref->leaf;
+            return;
+          }
+          auto [byte, child] = next_child(ref, 0);
+          stack_.push_back({ref, size_t{byte} + 1, key_.size()});
+          key_.push_back(byte);
+          ref = child;
+        }
+        leaf_ = as_leaf(ref);
+        auto suffix = leaf_->suffix();
+        key_.insert(key_.end(), suffix.begin(), suffix.end());
+      }
+
+      // Moves to first key after subtrees already visited.
+      void next() {
+        while (not stack_.empty()) {
+          auto &frame = stack_.back();
+          auto [byte, child] = next_child(frame.node, frame.next);
+          if (child == nullptr) {
+            stack_.pop_back();
+            continue;
+          }
+          frame.next = byte + 1;
+          key_.resize(frame.depth);
+          key_.push_back(byte);
+          descend(child);
+          return;
+        }
+        key_.clear();
+        leaf_ = nullptr;
+      }
+
+      std::vector<Frame> stack_;
+      Bytes key_;
+      Leaf *leaf_ = nullptr;
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    RadixTree() = default;
+
+    RadixTree(RadixTree &&other) noexcept
+        : root_{std::exchange(other.root_, nullptr)},
+          size_{std::exchange(other.size_, 0)} {}
+
+    RadixTree &operator=(RadixTree &&other) noexcept {
+      RadixTree{std::move(other)}.swap(*this);
+      return *this;
+    }
+
+    ~RadixTree() {
+      destroy(root_);
+    }
+
+    void swap(RadixTree &other) noexcept {
+      std::swap(root_, other.root_);
+      std::swap(size_, other.size_);
+    }
+
+    size_t size() const {
+      return size_;
+    }
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    iterator begin() {
+      iterator it;
+      if (root_ != nullptr) {
+        it.descend(root_);
+      }
+      return it;
+    }
+    iterator end() {
+      return {};
+    }
+    const_iterator begin() const {
+      return const_cast<RadixTree &>(*this).begin();
+    }
+    const_iterator end() const {
+      return {};
+    }
+
+    V *find(BytesIn key) {
+      auto leaf = find_leaf(key);
+      return leaf != nullptr ? &leaf->value : nullptr;
+    }
+    const V *find(BytesIn key) const {
+      return const_cast<RadixTree &>(*this).find(key);
+    }
+
+    bool contains(BytesIn key) const {
+      return find_leaf(key) != nullptr;
+    }
+
+    // First key not less than `key`.
+    iterator lower_bound(BytesIn key) {
+      return seek(key);
+    }
+    const_iterator lower_bound(BytesIn key) const {
+      return const_cast<RadixTree &>(*this).seek(key);
+    }
+
+    // Keys starting with `prefix`, in order.
+    std::ranges::subrange<iterator> prefix(BytesIn prefix) {
+      return {seek(prefix), prefix_end(prefix)};
+    }
+    std::ranges::subrange<const_iterator> prefix(BytesIn prefix) const {
+      auto range = const_cast<RadixTree &>(*this).prefix(prefix);
+      return {range.begin(), range.end()};
+    }
+
+    template <typename... Args>
+    std::pair<V *, bool> try_emplace(BytesIn key, Args &&...args) {
+      return emplace_key(key, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    std::pair<V *, bool> insert_or_assign(BytesIn key, T &&value) {
+      auto r = emplace_key(key, std::forward<T>(value));
+      if (not r.second) {
+        *r.first = std::forward<T>(value);
+      }
+      return r;
+    }
+
+    V &operator[](BytesIn key) {
+      return *emplace_key(key).first;
+    }
+
+    size_t erase(BytesIn key) {
+      if (not erase_key(root_, key)) {
+        return 0;
+      }
+      --size_;
+      return 1;
+    }
+
+    void clear() {
+      destroy(std::exchange(root_, nullptr));
+      size_ = 0;
+    }
+
+   private:
+    static constexpr size_t kInlinePrefix = 8;
+
+    enum class NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+    // Value followed by key bytes below parent, in one allocation.
+    struct Leaf {
+      template <typename... Args>
+      explicit Leaf(size_t size, Args &&...args)
+          : value(std::forward<Args>(args)...), size{size} {}
+
+      uint8_t *data() {
+        return reinterpret_cast<uint8_t *>(this + 1);
+      }
+      BytesIn suffix() {
+        return {data(), size};
+      }
+
+      V value;
+      size_t size;
+    };
+
+    struct Node {
+      explicit Node(NodeType type) : type{type} {}
+
+      NodeType type;
+      uint16_t count = 0;
+      uint32_t prefix_len = 0;
+      // Compressed path, heap allocated when longer than inline.
+      union {
+        std::array<uint8_t, kInlinePrefix> bytes{};
+        uint8_t *heap;
+      } prefix;
+      // Key which ends after prefix.
+      Leaf *leaf = nullptr;
+    };
+
+    // Sorted keys.
+    struct Node4 : Node {
+      Node4() : Node{NodeType::NODE4} {}
+
+      std::array<uint8_t, 4> keys{};
+      std::array<Node *, 4> children{};
+    };
+
+    struct Node16 : Node {
+      Node16() : Node{NodeType::NODE16} {}
+
+      std::array<uint8_t, 16> keys{};
+      std::array<Node *, 16> children{};
+    };
+
+    // `index` holds slot + 1 in `children`, 0 when absent.
+    struct Node48 : Node {
+      Node48() : Node{NodeType::NODE48} {}
+
+      std::array<uint8_t, 256> index{};
+      std::array<Node *, 48> children{};
+    };
+
+    struct Node256 : Node {
+      Node256() : Node{NodeType::NODE256} {}
+
+      std::array<Node *, 256> children{};
+    };
+
+    // Child pointers to leaves are tagged with low bit.
+    static bool is_leaf(const Node *ref) {
+      return (reinterpret_cast<uintptr_t>(ref) & 1) != 0;
+    }
+    static Leaf *as_leaf(const Node *ref) {
+      return reinterpret_cast<Leaf *>(reinterpret_cast<uintptr_t>(ref) - 1);
+    }
+    static Node *tag(Leaf *leaf) {
+      return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(leaf) + 1);
+    }
+
+    template <typename... Args>
+    static Leaf *new_leaf(size_t size, Args &&...args) {
+      void *ptr = ::operator new(sizeof(Leaf) + size);
+      try {
+        return ::new (ptr) Leaf{size, std::forward<Args>(args)...};
+      } catch (...) {
+        ::operator delete(ptr);
+        throw;
+      }
+    }
+
+    template <typename... Args>
+    static Leaf *make_leaf(BytesIn suffix, Args &&...args) {
+      auto leaf = new_leaf(suffix.size(), std::forward<Args>(args)...);
+      std::ranges::copy(suffix, leaf->data());
+      return leaf;
+    }
+
+    static void free_leaf(Leaf *leaf) {
+      leaf->~Leaf();
+      ::operator delete(leaf);
+    }
+
+    // Drops first `n` suffix bytes, when leaf moves below new node.
+    static void trim(Leaf *leaf, size_t n) {
+      if (n < leaf->size) {
+        memmove(leaf->data(), leaf->data() + n, leaf->size - n);
+      }
+      leaf->size -= n;
+    }
+
+    // Moves leaf up in place of removed node, prepending node path.
+    static Leaf *lift(Leaf *leaf, BytesIn prefix, BytesIn edge) {
+      auto suffix = leaf->suffix();
+      auto lifted = new_leaf(prefix.size() + edge.size() + suffix.size(),
+          std::move(leaf->value));
+      auto out = std::ranges::copy(prefix, lifted->data()).out;
+      out = std::ranges::copy(edge, out).out;
+      std::ranges::copy(suffix, out);
+      free_leaf(leaf);
+      return lifted;
+    }
+
+    static BytesIn prefix_of(const Node *node) {
+      return {node->prefix_len <= kInlinePrefix ? node->prefix.bytes.data()
+                                                : node->prefix.heap,
+          node->prefix_len};
+    }
+
+    // `bytes` may point into node own prefix.
+    static void set_prefix(Node *node, BytesIn bytes) {
+      uint8_t *old = node->prefix_len > kInlinePrefix ? node->prefix.heap
+                                                      : nullptr;
+      if (bytes.size() > kInlinePrefix) {
+        auto heap = new uint8_t[bytes.size()];
+        std::ranges::copy(bytes, heap);
+        node->prefix.heap = heap;
+      } else if (not bytes.empty()) {
+        memmove(node->prefix.bytes.data(), bytes.data(), bytes.size());
+      }
+      node->prefix_len = bytes.size();
+      delete[] old;
+    }
+
+    static void free_prefix(Node *node) {
+      if (node->prefix_len > kInlinePrefix) {
+        delete[] node->prefix.heap;
+      }
+      node->prefix_len = 0;
+    }
+
+    static size_t common_prefix(BytesIn l, BytesIn r) {
+      auto n = std::min(l.size(), r.size());
+      return std::mismatch(l.begin(), l.begin() + n, r.begin()).first
+           - l.begin();
+    }
+
+    // Bit `i` is set when `keys[i] == byte`.
+    static uint32_t match16(const Node16 *node, uint8_t byte) {
+#ifdef __SSE2__
+      auto keys = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(node->keys.data()));
+      uint32_t mask = _mm_movemask_epi8(
+          _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(byte))));
+#else
+      uint32_t mask = 0;
+      for (size_t i = 0; i < node->count; ++i) {
+        mask |= uint32_t{node->keys[i] == byte} << i;
+      }
+#endif
+      return mask & ((1u << node->count) - 1);
+    }
+
+    // Number of keys less than `byte`.
+    static size_t rank16(const Node16 *node, uint8_t byte) {
+#ifdef __SSE2__
+      // SSE2 compares signed bytes, flip sign bit for unsigned order.
+      auto flip = _mm_set1_epi8(-128);
+      auto keys = _mm_xor_si128(flip,
+          _mm_loadu_si128(
+              reinterpret_cast<const __m128i *>(node->keys.data())));
+      auto less = _mm_cmplt_epi8(
+          keys, _mm_xor_si128(flip, _mm_set1_epi8(static_cast<char>(byte))));
+      uint32_t mask = _mm_movemask_epi8(less) & ((1u << node->count) - 1);
+      return std::popcount(mask);
+#else
+      size_t i = 0;
+      while (i < node->count and node->keys[i] < byte) {
+        ++i;
+      }
+      return i;
+#endif
+    }
+
+    static Node **find_child(Node *node, uint8_t byte) {
+      switch (node->type) {
+        case NodeType::NODE4: {
+          auto n = static_cast<Node4 *>(node);
+          for (size_t i = 0; i < n->count; ++i) {
+            if (n->keys[i] == byte) {
+              return &n->children[i];
+            }
+          }
+          return nullptr;
+        }
+        case NodeType::NODE16: {
+          auto n = static_cast<Node16 *>(node);
+          auto mask = match16(n, byte);
+          return mask != 0 ? &n->children[std::countr_zero(mask)] : nullptr;
+        }
+        case NodeType::NODE48: {
+          auto n = static_cast<Node48 *>(node);
+          auto i = n->index[byte];
+          return i != 0 ? &n->children[i - 1] : nullptr;
+        }
+        case NodeType::NODE256: {
+          auto n = static_cast<Node256 *>(node);
+          return n->children[byte] != nullptr ? &n->children[byte] : nullptr;
+        }
+      }
+      return nullptr;
+    }
+
+    // First child with key byte not less than `from`, null when none.
+    static std::pair<uint8_t, Node *> next_child(Node *node, size_t from) {
+      switch (node->type) {
+        case NodeType::NODE4: {
+          auto n = static_cast<Node4 *>(node);
+          for (size_t i = 0; i < n->count; ++i) {
+            if (n->keys[i] >= from) {
+              return {n->keys[i], n->children[i]};
+            }
+          }
+          break;
+        }
+        case NodeType::NODE16: {
+          auto n = static_cast<Node16 *>(node);
+          if (from > 0xff) {
+            break;
+          }
+          auto i = rank16(n, from);
+          if (i < n->count) {
+            return {n->keys[i], n->children[i]};
+          }
+          break;
+        }
+        case NodeType::NODE48: {
+          auto n = static_cast<Node48 *>(node);
+          for (size_t b = from; b <= 0xff; ++b) {
+            if (n->index[b] != 0) {
+              return {b, n->children[n->index[b] - 1]};
+            }
+          }
+          break;
+        }
+        case NodeType::NODE256: {
+          auto n = static_cast<Node256 *>(node);
+          for (size_t b = from; b <= 0xff; ++b) {
+            if (n->children[b] != nullptr) {
+              return {b, n->children[b]};
+            }
+          }
+          break;
+        }
+      }
+      return {0, nullptr};
+    }
+
+    template <typename N>
+    static void insert_sorted(N *node, uint8_t byte, Node *child) {
+      size_t i = node->count;
+      while (i > 0 and node->keys[i - 1] > byte) {
+        node->keys[i] = node->keys[i - 1];
+        node->children[i] = node->children[i - 1];
+        --i;
+      }
+      node->keys[i] = byte;
+      node->children[i] = child;
+    }
+
+    template <typename N>
+    static void erase_sorted(N *node, size_t i) {
+      std::copy(node->keys.begin() + i + 1,
+          node->keys.begin() + node->count,
+          node->keys.begin() + i);
+      std::copy(node->children.begin() + i + 1,
+          node->children.begin() + node->count,
+          node->children.begin() + i);
+    }
+
+    // Node must have room.
+    template <typename N>
+    static void insert_into(N *node, uint8_t byte, Node *child) {
+      if constexpr (std::is_same_v<N, Node48>) {
+        size_t i = 0;
+        while (node->children[i] != nullptr) {
+          ++i;
+        }
+        node->children[i] = child;
+        node->index[byte] = i + 1;
+      } else if constexpr (std::is_same_v<N, Node256>) {
+        node->children[byte] = child;
+      } else {
+        insert_sorted(node, byte, child);
+      }
+      ++node->count;
+    }
+
+    static void insert_child(Node *node, uint8_t byte, Node *child) {
+      switch (node->type) {
+        case NodeType::NODE4:
+          insert_into(static_cast<Node4 *>(node), byte, child);
+          break;
+        case NodeType::NODE16:
+          insert_into(static_cast<Node16 *>(node), byte, child);
+          break;
+        case NodeType::NODE48:
+          insert_into(static_cast<Node48 *>(node), byte, child);
+          break;
+        case NodeType::NODE256:
+          insert_into(static_cast<Node256 *>(node), byte, child);
+          break;
+      }
+    }
+
+    static size_t capacity(const Node *node) {
+      switch (node->type) {
+        case NodeType::NODE4:
+          return 4;
+        case NodeType::NODE16:
+          return 16;
+        case NodeType::NODE48:
+          return 48;
+        case NodeType::NODE256:
+          break;
+      }
+      return 256;
+    }
+
+    // Frees node itself, prefix and children are owned by caller.
+    static void delete_node(Node *node) {
+      switch (node->type) {
+        case NodeType::NODE4:
+          delete static_cast<Node4 *>(node);
+          break;
+        case NodeType::NODE16:
+          delete static_cast<Node16 *>(node);
+          break;
+        case NodeType::NODE48:
+          delete static_cast<Node48 *>(node);
+          break;
+        case NodeType::NODE256:
+          delete static_cast<Node256 *>(node);
+          break;
+      }
+    }
+
+    // Moves prefix, leaf and children into node of other size.
+    template <typename To>
+    static Node *convert(Node *from) {
+      auto to = new To;
+      to->prefix = from->prefix;
+      to->prefix_len = from->prefix_len;
+      to->leaf = from->leaf;
+      for (auto [byte, child] = next_child(from, 0); child != nullptr;
+          std::tie(byte, child) = next_child(from, byte + 1)) {
+        insert_into(to, byte, child);
+      }
+      delete_node(from);
+      return to;
+    }
+
+    static void add_child(Node *&ref, uint8_t byte, Node *child) {
+      if (ref->count == capacity(ref)) {
+        switch (ref->type) {
+          case NodeType::NODE4:
+            ref = convert<Node16>(ref);
+            break;
+          case NodeType::NODE16:
+            ref = convert<Node48>(ref);
+            break;
+          case NodeType::NODE48:
+            ref = convert<Node256>(ref);
+            break;
+          case NodeType::NODE256:
+            break;
+        }
+      }
+      insert_child(ref, byte, child);
+    }
+
+    static void remove_child(Node *&ref, uint8_t byte) {
+      auto node = ref;
+      switch (node->type) {
+        case NodeType::NODE4: {
+          auto n = static_cast<Node4 *>(node);
+          auto keys = n->keys.begin();
+          erase_sorted(n, std::find(keys, keys + n->count, byte) - keys);
+          break;
+        }
+        case NodeType::NODE16: {
+          auto n = static_cast<Node16 *>(node);
+          erase_sorted(n, std::countr_zero(match16(n, byte)));
+          break;
+        }
+        case NodeType::NODE48: {
+          auto n = static_cast<Node48 *>(node);
+          n->children[n->index[byte] - 1] = nullptr;
+          n->index[byte] = 0;
+          break;
+        }
+        case NodeType::NODE256:
+          static_cast<Node256 *>(node)->children[byte] = nullptr;
+          break;
+      }
+      --node->count;
+      shrink(ref);
+    }
+
+    // Converts to smaller node only when children fit with room to spare,
+    // so add and remove at boundary don't convert back and forth.
+    static void shrink(Node *&ref) {
+      switch (ref->type) {
+        case NodeType::NODE4:
+          collapse(ref);
+          break;
+        case NodeType::NODE16:
+          if (ref->count <= 3) {
+            ref = convert<Node4>(ref);
+          }
+          break;
+        case NodeType::NODE48:
+          if (ref->count <= 12) {
+            ref = convert<Node16>(ref);
+          }
+          break;
+        case NodeType::NODE256:
+          if (ref->count <= 40) {
+            ref = convert<Node48>(ref);
+          }
+          break;
+      }
+    }
+
+    // Replaces node with its only entry, merging paths.
+    static void collapse(Node *&ref) {
+      auto node = static_cast<Node4 *>(ref);
+      if (node->count == 0) {
+        ref = node->leaf != nullptr
+                ? tag(lift(node->leaf, prefix_of(node), {}))
+                : nullptr;
+      } else if (node->count == 1 and node->leaf == nullptr) {
+        auto edge = node->keys[0];
+        auto child = node->children[0];
+        if (is_leaf(child)) {
+          ref = tag(lift(as_leaf(child), prefix_of(node), {&edge, 1}));
+        } else {
+          auto prefix = prefix_of(node);
+          auto tail = prefix_of(child);
+          Bytes path;
+          path.reserve(prefix.size() + 1 + tail.size());
+          path.insert(path.end(), prefix.begin(), prefix.end());
+          path.push_back(edge);
+          path.insert(path.end(), tail.begin(), tail.end());
+          set_prefix(child, path);
+          ref = child;
+        }
+      } else {
+        return;
+      }
+      free_prefix(node);
+      delete node;
+    }
+
+    static void destroy(Node *ref) {
+      if (ref == nullptr) {
+        return;
+      }
+      if (is_leaf(ref)) {
+        free_leaf(as_leaf(ref));
+        return;
+      }
+      if (ref->leaf != nullptr) {
+        free_leaf(ref->leaf);
+      }
+      for (auto [byte, child] = next_child(ref, 0); child != nullptr;
+          std::tie(byte, child) = next_child(ref, byte + 1)) {
+        destroy(child);
+      }
+      free_prefix(ref);
+      delete_node(ref);
+    }
+
+    Leaf *find_leaf(BytesIn key) const {
+      auto ref = root_;
+      while (ref != nullptr) {
+        if (is_leaf(ref)) {
+          auto leaf = as_leaf(ref);
+          return bytes_equal(leaf->suffix(), key) ? leaf : nullptr;
+        }
+        auto prefix = prefix_of(ref);
+        if (key.size() < prefix.size()
+            or not bytes_equal(key.first(prefix.size()), prefix)) {
+          return nullptr;
+        }
+        key = key.subspan(prefix.size());
+        if (key.empty()) {
+          return ref->leaf;
+        }
+        auto child = find_child(ref, key[0]);
+        if (child == nullptr) {
+          return nullptr;
+        }
+        ref = *child;
+        key = key.subspan(1);
+      }
+      return nullptr;
+    }
+
+    template <typename... Args>
+    std::pair<V *, bool> emplace_key(BytesIn key, Args &&...args) {
+      // Adds key `rest` below prefix of node `ref`.
+      auto place = [&](Node *&ref, BytesIn rest) {
+        Leaf *leaf;
+        if (rest.empty()) {
+          leaf = make_leaf({}, std::forward<Args>(args)...);
+          ref->leaf = leaf;
+        } else {
+          leaf = make_leaf(rest.subspan(1), std::forward<Args>(args)...);
+          add_child(ref, rest[0], tag(leaf));
+        }
+        ++size_;
+        return std::pair{&leaf->value, true};
+      };
+      auto ref = &root_;
+      for (;;) {
+        auto node = *ref;
+        if (node == nullptr) {
+          auto leaf = make_leaf(key, std::forward<Args>(args)...);
+          *ref = tag(leaf);
+          ++size_;
+          return {&leaf->value, true};
+        }
+        if (is_leaf(node)) {
+          auto old = as_leaf(node);
+          auto suffix = old->suffix();
+          auto same = common_prefix(suffix, key);
+          if (same == suffix.size() and same == key.size()) {
+            return {&old->value, false};
+          }
+          auto split = new Node4;
+          set_prefix(split, key.first(same));
+          if (same == suffix.size()) {
+            split->leaf = old;
+          } else {
+            insert_into(split, suffix[same], node);
+          }
+          trim(old, std::min(same + 1, suffix.size()));
+          *ref = split;
+          return place(*ref, key.subspan(same));
+        }
+        auto prefix = prefix_of(node);
+        auto same = common_prefix(prefix, key);
+        if (same < prefix.size()) {
+          auto split = new Node4;
+          set_prefix(split, prefix.first(same));
+          insert_into(split, prefix[same], node);
+          set_prefix(node, prefix.subspan(same + 1));
+          *ref = split;
+          return place(*ref, key.subspan(same));
+        }
+        key = key.subspan(same);
+        if (key.empty()) {
+          if (node->leaf != nullptr) {
+            return {&node->leaf->value, false};
+          }
+          return place(*ref, key);
+        }
+        auto child = find_child(node, key[0]);
+        if (child == nullptr) {
+          return place(*ref, key);
+        }
+        ref = child;
+        key = key.subspan(1);
+      }
+    }
+
+    static bool erase_key(Node *&ref, BytesIn key) {
+      auto node = ref;
+      if (node == nullptr) {
+        return false;
+      }
+      if (is_leaf(node)) {
+        auto leaf = as_leaf(node);
+        if (not bytes_equal(leaf->suffix(), key)) {
+          return false;
+        }
+        free_leaf(leaf);
+        ref = nullptr;
+        return true;
+      }
+      auto prefix = prefix_of(node);
+      if (key.size() < prefix.size()
+          or not bytes_equal(key.first(prefix.size()), prefix)) {
+        return false;
+      }
+      key = key.subspan(prefix.size());
+      if (key.empty()) {
+        if (node->leaf == nullptr) {
+          return false;
+        }
+        free_leaf(std::exchange(node->leaf, nullptr));
+        shrink(ref);
+        return true;
+      }
+      auto child = find_child(node, key[0]);
+      if (child == nullptr or not erase_key(*child, key.subspan(1))) {
+        return false;
+      }
+      if (*child == nullptr) {
+        remove_child(ref, key[0]);
+      }
+      return true;
+    }
+
+    iterator seek(BytesIn key) {
+      iterator it;
+      auto ref = root_;
+      if (ref == nullptr) {
+        return it;
+      }
+      for (;;) {
+        if (is_leaf(ref)) {
+          auto leaf = as_leaf(ref);
+          auto suffix = leaf->suffix();
+          if (bytes_compare(suffix, key) >= 0) {
+            it.key_.insert(it.key_.end(), suffix.begin(), suffix.end());
+            it.leaf_ = leaf;
+          } else {
+            it.next();
+          }
+          return it;
+        }
+        auto prefix = prefix_of(ref);
+        auto n = std::min(prefix.size(), key.size());
+        auto order = bytes_compare(key.first(n), prefix.first(n));
+        if (order > 0) {
+          it.next();
+          return it;
+        }
+        if (order < 0 or key.size() <= prefix.size()) {
+          it.descend(ref);
+          return it;
+        }
+        it.key_.insert(it.key_.end(), prefix.begin(), prefix.end());
+        key = key.subspan(prefix.size());
+        it.stack_.push_back({ref, size_t{key[0]} + 1, it.key_.size()});
+        auto child = find_child(ref, key[0]);
+        if (child == nullptr) {
+          it.next();
+          return it;
+        }
+        it.key_.push_back(key[0]);
+        ref = *child;
+        key = key.subspan(1);
+      }
+    }
+
+    // First key after all keys starting with `prefix`.
+    iterator prefix_end(BytesIn prefix) {
+      Bytes next{prefix.begin(), prefix.end()};
+      while (not next.empty() and next.back() == 0xff) {
+        next.pop_back();
+      }
+      if (next.empty()) {
+        return end();
+      }
+      ++next.back();
+      return seek(next);
+    }
+
+    Node *root_ = nullptr;
+    size_t size_ = 0;
+  };
+}  // namespace qtils
@@ -0,0 +1,150 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <compare>
+#include <cstring>
+#include <new>
+
+#include <qtils/bytes.hpp>
+#include <qtils/bytes_hash.hpp>
+#include <qtils/hex.hpp>
+
+namespace qtils {
+  /**
+   * Immutable reference-counted bytes.
+   * Refcount and bytes share one allocation, copy is atomic increment.
+   * `slice` shares parent allocation and keeps it alive.
+   * Converts to `BytesIn`.
+   */
+  class SharedBytes {
+   public:
+    using value_type = uint8_t;
+    using size_type = size_t;
+    using iterator = const uint8_t *;
+    using const_iterator = const uint8_t *;
+
+    SharedBytes() = default;
+
+    explicit SharedBytes(BytesIn bytes) {
+      if (bytes.empty()) {
+        return;
+      }
+      void *ptr = ::operator new(sizeof(Header) + bytes.size());
+      header_ = ::new (ptr) Header{};
+      auto data = reinterpret_cast<uint8_t *>(header_ + 1);
+      memcpy(data, bytes.data(), bytes.size());
+      data_ = data;
+      size_ = bytes.size();
+    }
+
+    SharedBytes(const SharedBytes &other)
+        : header_{other.header_}, data_{other.data_}, size_{other.size_} {
+      if (header_) {
+        header_->refs.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    SharedBytes(SharedBytes &&other) noexcept
+        : header_{std::exchange(other.header_, nullptr)},
+          data_{std::exchange(other.data_, nullptr)},
+          size_{std::exchange(other.size_, 0)} {}
+
+    SharedBytes &operator=(const SharedBytes &other) {
+      SharedBytes{other}.swap(*this);
+      return *this;
+    }
+
+    SharedBytes &operator=(SharedBytes &&other) noexcept {
+      SharedBytes{std::move(other)}.swap(*this);
+      return *this;
+    }
+
+    ~SharedBytes() {
+      if (header_
+          and header_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        header_->~Header();
+        ::operator delete(header_);
+      }
+    }
+
+    void swap(SharedBytes &other) noexcept {
+      std::swap(header_, other.header_);
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+    }
+
+    const uint8_t *data() const {
+      return data_;
+    }
+    size_t size() const {
+      return size_;
+    }
+    bool empty() const {
+      return size_ == 0;
+    }
+    const_iterator begin() const {
+      return data_;
+    }
+    const_iterator end() const {
+      return data_ + size_;
+    }
+    uint8_t operator[](size_t i) const {
+      return data_[i];
+    }
+
+    BytesIn view() const {
+      return {data_, size_};
+    }
+    operator BytesIn() const {
+      return view();
+    }
+
+    // Number of owners of underlying allocation, 0 when empty.
+    size_t use_count() const {
+      return header_ ? header_->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     * Shares allocation, `size` is clamped to end.
+     * Precondition: `offset <= size()`.
+     */
+    SharedBytes slice(size_t offset, size_t size = SIZE_MAX) const {
+      assert(offset <= size_);
+      SharedBytes slice{*this};
+      slice.data_ += offset;
+      slice.size_ = std::min(size, size_ - offset);
+      return slice;
+    }
+
+    bool operator==(const SharedBytes &other) const {
+      return std::ranges::equal(*this, other);
+    }
+    auto operator<=>(const SharedBytes &other) const {
+      return std::lexicographical_compare_three_way(
+          begin(), end(), other.begin(), other.end());
+    }
+
+   private:
+    struct alignas(std::max_align_t) Header {
+      std::atomic<size_t> refs{1};
+    };
+
+    Header *header_ = nullptr;
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+  };
+}  // namespace qtils
+
+template <>
+struct fmt::formatter<qtils::SharedBytes> : fmt::formatter<qtils::BytesIn> {};
+
+template <>
+struct std::hash<qtils::SharedBytes> : qtils::BytesHash {};
@@ -0,0 +1,78 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <string_view>
+
+#if defined(__x86_64__) or defined(__i386__)
+#define QTILS_SIMD_X86 1
+#define QTILS_SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace qtils {
+  enum class SimdLevel {
+    SCALAR,
+    SSE41,
+    AVX2,
+    AVX512,
+  };
+
+  inline std::string_view simd_level_name(SimdLevel level) {
+    switch (level) {
+      case SimdLevel::SCALAR:
+        return "scalar";
+      case SimdLevel::SSE41:
+        return "sse4.1";
+      case SimdLevel::AVX2:
+        return "avx2";
+      case SimdLevel::AVX512:
+        return "avx512";
+    }
+    abort();
+  }
+
+  // Best level supported by cpu and os.
+  inline SimdLevel detect_simd_level() {
+#ifdef QTILS_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")
+        and __builtin_cpu_supports("avx512bw")) {
+      return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+      return SimdLevel::SSE41;
+    }
+#endif
+    return SimdLevel::SCALAR;
+  }
+
+  /**
+   * Level used by kernels, detected once.
+   * `QTILS_SIMD` environment variable (e.g. "scalar" or "avx2") may lower it.
+   */
+  inline SimdLevel simd_level() {
+    static const SimdLevel level = [] {
+      auto level = detect_simd_level();
+      if (auto env = std::getenv("QTILS_SIMD")) {
+        for (auto forced : {SimdLevel::SCALAR,
+                 SimdLevel::SSE41,
+                 SimdLevel::AVX2,
+                 SimdLevel::AVX512}) {
+          if (simd_level_name(forced) == env and forced < level) {
+            level = forced;
+          }
+        }
+      }
+      return level;
+    }();
+    return level;
+  }
+}  // namespace qtils
@@ -0,0 +1,198 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstring>
+#include <initializer_list>
+
+#include <qtils/bytes.hpp>
+#include <qtils/bytes_hash.hpp>
+#include <qtils/hex.hpp>
+
+namespace qtils {
+  /**
+   * Byte vector which keeps up to `N` bytes inline and moves to heap only
+   * when grown beyond that.
+   * Converts to `BytesIn`/`BytesOut` like `Bytes`.
+   */
+  template <size_t N>
+  class SmallBytes {
+    static_assert(N != 0);
+
+   public:
+    using value_type = uint8_t;
+    using size_type = size_t;
+    using iterator = uint8_t *;
+    using const_iterator = const uint8_t *;
+
+    SmallBytes() = default;
+
+    explicit SmallBytes(size_t size) {
+      resize(size);
+    }
+
+    explicit SmallBytes(BytesIn bytes) {
+      assign(bytes);
+    }
+
+    SmallBytes(std::initializer_list<uint8_t> bytes) {
+      assign(BytesIn{bytes.begin(), bytes.size()});
+    }
+
+    SmallBytes(const SmallBytes &other) {
+      assign(other);
+    }
+
+    SmallBytes(SmallBytes &&other) noexcept {
+      steal(other);
+    }
+
+    SmallBytes &operator=(const SmallBytes &other) {
+      if (this != &other) {
+        assign(other);
+      }
+      return *this;
+    }
+
+    SmallBytes &operator=(SmallBytes &&other) noexcept {
+      if (this != &other) {
+        free();
+        steal(other);
+      }
+      return *this;
+    }
+
+    ~SmallBytes() {
+      free();
+    }
+
+    bool is_inline() const {
+      return capacity_ == N;
+    }
+
+    uint8_t *data() {
+      return is_inline() ? storage_.inline_ : storage_.heap_;
+    }
+    const uint8_t *data() const {
+      return is_inline() ? storage_.inline_ : storage_.heap_;
+    }
+    size_t size() const {
+      return size_;
+    }
+    size_t capacity() const {
+      return capacity_;
+    }
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    iterator begin() {
+      return data();
+    }
+    iterator end() {
+      return data() + size_;
+    }
+    const_iterator begin() const {
+      return data();
+    }
+    const_iterator end() const {
+      return data() + size_;
+    }
+
+    uint8_t &operator[](size_t i) {
+      return data()[i];
+    }
+    uint8_t operator[](size_t i) const {
+      return data()[i];
+    }
+
+    void reserve(size_t capacity) {
+      if (capacity <= capacity_) {
+        return;
+      }
+      capacity = std::max(capacity, 2 * capacity_);
+      auto heap = new uint8_t[capacity];
+      memcpy(heap, data(), size_);
+      free();
+      storage_.heap_ = heap;
+      capacity_ = capacity;
+    }
+
+    void resize(size_t size) {
+      reserve(size);
+      if (size > size_) {
+        memset(data() + size_, 0, size - size_);
+      }
+      size_ = size;
+    }
+
+    // Leaves new bytes uninitialized.
+    void resize_uninitialized(size_t size) {
+      reserve(size);
+      size_ = size;
+    }
+
+    void push_back(uint8_t byte) {
+      reserve(size_ + 1);
+      data()[size_++] = byte;
+    }
+
+    void clear() {
+      size_ = 0;
+    }
+
+    void assign(BytesIn bytes) {
+      size_ = 0;
+      reserve(bytes.size());
+      memcpy(data(), bytes.data(), bytes.size());
+      size_ = bytes.size();
+    }
+
+    bool operator==(const SmallBytes &other) const {
+      return std::ranges::equal(*this, other);
+    }
+    auto operator<=>(const SmallBytes &other) const {
+      return std::lexicographical_compare_three_way(
+          begin(), end(), other.begin(), other.end());
+    }
+
+   private:
+    void free() {
+      if (not is_inline()) {
+        delete[] storage_.heap_;
+      }
+    }
+
+    // Takes heap buffer or copies inline bytes, leaves `other` empty.
+    void steal(SmallBytes &other) {
+      if (other.is_inline()) {
+        memcpy(storage_.inline_, other.storage_.inline_, other.size_);
+      } else {
+        storage_.heap_ = other.storage_.heap_;
+      }
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      other.size_ = 0;
+      other.capacity_ = N;
+    }
+
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    union Storage {
+      uint8_t inline_[N];
+      uint8_t *heap_;
+    } storage_;
+  };
+}  // namespace qtils
+
+template <size_t N>
+struct fmt::formatter<qtils::SmallBytes<N>> : fmt::formatter<qtils::BytesIn> {};
+
+template <size_t N>
+struct std::hash<qtils::SmallBytes<N>> : qtils::BytesHash {};
@@ -6,9 +6,13 @@
 
 #pragma once
 
-#include <boost/algorithm/hex.hpp>
+#include <algorithm>
+#include <concepts>
+
 #include <qtils/bytes.hpp>
+#include <qtils/bytestr.hpp>
 #include <qtils/enum_error_code.hpp>
+#include <qtils/hex_kernel.hpp>
 #include <qtils/outcome.hpp>
 
 namespace qtils {
@@ -39,18 +43,64 @@ namespace qtils {
     abort();
   }
 
-  template <typename T = Bytes>
-  outcome::result<T> unhex(std::string_view s) {
+}  // namespace qtils
+
+namespace qtils::detail {
+  // Checks prefix and parity, returns decoded size.
+  inline outcome::result<size_t> unhex_size(std::string_view s) {
     if (s.starts_with("0x")) {
       return UnhexError::UNEXPECTED_0X;
     }
     if (s.size() % 2 != 0) {
       return UnhexError::ODD_LENGTH;
     }
-    auto count = s.size() / 2;
+    return s.size() / 2;
+  }
+}  // namespace qtils::detail
+
+namespace qtils {
+  // Decodes into front of `out`, returns number of bytes written.
+  inline outcome::result<size_t> unhex_to(BytesOut out, std::string_view s) {
+    OUTCOME_TRY(count, detail::unhex_size(s));
+    if (count > out.size()) {
+      return UnhexError::TOO_LONG;
+    }
+    if (not hex_kernel::decode(out.data(), s.data(), count)) {
+      return UnhexError::NON_HEX;
+    }
+    return count;
+  }
+
+  inline outcome::result<size_t> unhex0x_to(
+      BytesOut out, std::string_view s, bool optional_0x = false) {
+    if (s.starts_with("0x")) {
+      s.remove_prefix(2);
+    } else if (not optional_0x) {
+      return UnhexError::REQUIRED_0X;
+    }
+    return unhex_to(out, s);
+  }
+
+  // Decodes over front of `s`, which is clobbered even on error.
+  inline outcome::result<BytesOut> unhex_inplace(std::span<char> s) {
+    auto out = str2byte(s);
+    OUTCOME_TRY(count, unhex_to(out, byte2str(out)));
+    return out.first(count);
+  }
+
+  inline outcome::result<BytesOut> unhex0x_inplace(
+      std::span<char> s, bool optional_0x = false) {
+    auto out = str2byte(s);
+    OUTCOME_TRY(count, unhex0x_to(out, byte2str(out), optional_0x));
+    return out.first(count);
+  }
+
+  template <typename T = Bytes>
+  outcome::result<T> unhex(std::string_view s) {
+    OUTCOME_TRY(count, detail::unhex_size(s));
     T t;
     if constexpr (requires(T t) { t.resize(size_t{}); }) {
-      t.resize(count);
+      resize_uninitialized(t, count);
     } else {
       if (count < t.size()) {
         return UnhexError::TOO_SHORT;
@@ -59,9 +109,7 @@ namespace qtils {
         return UnhexError::TOO_LONG;
       }
     }
-    try {
-      boost::algorithm::unhex(s.begin(), s.end(), t.begin());
-    } catch (const boost::algorithm::non_hex_input &) {
+    if (not hex_kernel::decode(t.data(), s.data(), count)) {
       return UnhexError::NON_HEX;
     }
     return t;
@@ -77,7 +125,65 @@ namespace qtils {
     return unhex<T>(s);
   }
 
+  // Stray pointer would otherwise convert to `optional_0x`.
+  template <typename T = Bytes>
+  outcome::result<T> unhex0x(std::string_view s, const void *) = delete;
+
+  // Decodes into container with allocator, e.g. `unhex<pmr::Bytes>(s, &arena)`.
+  template <ResizableBytes T>
+  outcome::result<T> unhex(
+      std::string_view s, const typename T::allocator_type &alloc) {
+    OUTCOME_TRY(count, detail::unhex_size(s));
+    T t(alloc);
+    resize_uninitialized(t, count);
+    if (not hex_kernel::decode(t.data(), s.data(), count)) {
+      return UnhexError::NON_HEX;
+    }
+    return t;
+  }
+
+  /**
+   * Allocator comes before flag, e.g. `unhex0x<pmr::Bytes>(s, &arena)`.
+   * Deduced, so resource pointer matches exactly instead of converting
+   * to `bool`.
+   */
+  template <ResizableBytes T, typename Alloc>
+    requires std::convertible_to<const Alloc &, typename T::allocator_type>
+  outcome::result<T> unhex0x(
+      std::string_view s, const Alloc &alloc, bool optional_0x = false) {
+    if (s.starts_with("0x")) {
+      s.remove_prefix(2);
+    } else if (not optional_0x) {
+      return UnhexError::REQUIRED_0X;
+    }
+    return unhex<T>(s, typename T::allocator_type(alloc));
+  }
+
   inline auto operator""_unhex(const char *c, size_t s) {
     return unhex(std::string_view{c, s}).value();
   }
+
+  template <size_t N>
+  struct UnhexLiteral {
+    consteval UnhexLiteral(const char (&s)[N]) {
+      std::copy_n(s, N, chars);
+    }
+    constexpr std::string_view view() const {
+      return {chars, N - 1};
+    }
+    char chars[N];
+  };
+
+  // Decodes at compile time, malformed literal doesn't compile.
+  template <UnhexLiteral s>
+  consteval auto operator""_unhexN() {
+    constexpr auto str = s.view();
+    static_assert(not str.starts_with("0x"), "UNEXPECTED_0X");
+    static_assert(str.size() % 2 == 0, "ODD_LENGTH");
+    BytesN<str.size() / 2> bytes{};
+    if (not hex_kernel::decode_scalar(bytes.data(), str.data(), bytes.size())) {
+      throw "NON_HEX";
+    }
+    return bytes;
+  }
 }  // namespace qtils
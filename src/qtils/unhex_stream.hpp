@@ -0,0 +1,138 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <concepts>
+#include <optional>
+
+#include <qtils/unhex.hpp>
+
+namespace qtils {
+  // Incremental `unhex`/`unhex0x` over chunks split at arbitrary positions.
+  class UnhexStream {
+   public:
+    enum class Prefix0x {
+      FORBIDDEN,
+      REQUIRED,
+      OPTIONAL,
+    };
+
+    explicit UnhexStream(Prefix0x prefix = Prefix0x::FORBIDDEN)
+        : prefix_{prefix} {}
+
+    // Decodes `chunk` into front of `out`, returns number of bytes written.
+    // `out` must have space for `(chunk.size() + 1) / 2` bytes.
+    outcome::result<size_t> feed(std::string_view chunk, BytesOut out) {
+      if (error_) {
+        return *error_;
+      }
+      if (out.size() < (chunk.size() + 1) / 2) {
+        return UnhexError::TOO_LONG;
+      }
+      auto begin = out.data(), ptr = begin;
+      while (not prefix_done_) {
+        while (head_size_ < head_.size() and not chunk.empty()) {
+          head_[head_size_++] = chunk.front();
+          chunk.remove_prefix(1);
+        }
+        if (head_size_ < head_.size()) {
+          return ptr - begin;
+        }
+        std::string_view head{head_.data(), head_.size()};
+        if (head == "0x") {
+          if (prefix_ == Prefix0x::FORBIDDEN) {
+            return fail(UnhexError::UNEXPECTED_0X);
+          }
+          // like `unhex0x`, rest of input is checked by `unhex`
+          prefix_ = Prefix0x::FORBIDDEN;
+          head_size_ = 0;
+        } else {
+          prefix_done_ = true;
+          if (prefix_ == Prefix0x::REQUIRED) {
+            return fail(UnhexError::REQUIRED_0X);
+          }
+          if (not decode(head, ptr)) {
+            return fail(UnhexError::NON_HEX);
+          }
+        }
+      }
+      if (not decode(chunk, ptr)) {
+        return fail(UnhexError::NON_HEX);
+      }
+      return ptr - begin;
+    }
+
+    // Decodes `chunk` and passes decoded bytes to `sink(BytesIn)`, sink may
+    // be stateful (e.g. mutable lambda).
+    template <typename Sink>
+      requires std::invocable<Sink &, BytesIn>
+    outcome::result<void> feed(std::string_view chunk, Sink &&sink) {
+      constexpr size_t kChars = 4096;
+      BytesN<kChars / 2> buffer;
+      while (not chunk.empty()) {
+        auto part = chunk.substr(0, kChars);
+        chunk.remove_prefix(part.size());
+        OUTCOME_TRY(count, feed(part, buffer));
+        if (count != 0) {
+          sink(BytesIn{buffer}.first(count));
+        }
+      }
+      return outcome::success();
+    }
+
+    // Reports errors which are known only at the end of input.
+    outcome::result<void> finish() {
+      if (error_) {
+        return *error_;
+      }
+      if (not prefix_done_ and prefix_ == Prefix0x::REQUIRED) {
+        return fail(UnhexError::REQUIRED_0X);
+      }
+      if (head_size_ % 2 != 0 or pending_) {
+        return fail(UnhexError::ODD_LENGTH);
+      }
+      return outcome::success();
+    }
+
+   private:
+    bool decode(std::string_view s, uint8_t *&out) {
+      if (s.empty()) {
+        return true;
+      }
+      if (pending_) {
+        char pair[] = {*pending_, s.front()};
+        if (not hex_kernel::decode_scalar(out, pair, 1)) {
+          return false;
+        }
+        ++out;
+        pending_.reset();
+        s.remove_prefix(1);
+      }
+      auto count = s.size() / 2;
+      if (not hex_kernel::decode(out, s.data(), count)) {
+        return false;
+      }
+      out += count;
+      if (s.size() % 2 != 0) {
+        pending_ = s.back();
+      }
+      return true;
+    }
+
+    UnhexError fail(UnhexError error) {
+      error_ = error;
+      return error;
+    }
+
+    Prefix0x prefix_;
+    bool prefix_done_ = false;
+    std::array<char, 2> head_{};
+    size_t head_size_ = 0;
+    std::optional<char> pending_;
+    std::optional<UnhexError> error_;
+  };
+}  // namespace qtils
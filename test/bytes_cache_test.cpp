@@ -0,0 +1,119 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <qtils/bytes_cache.hpp>
+
+using qtils::Bytes;
+
+namespace {
+  using Cache = qtils::BytesCache<Bytes, int>;
+
+  Bytes key(int i) {
+    return Bytes{static_cast<uint8_t>(i)};
+  }
+
+  // One shard of capacity 100 holding keys 0..9 of weight 10.
+  std::unique_ptr<Cache> full_cache() {
+    auto cache = std::make_unique<Cache>(100, 1);
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_TRUE(cache->put(key(i), i, 10));
+    }
+    return cache;
+  }
+}  // namespace
+
+TEST(BytesCache, InsertEvictsOldestUnreferenced) {
+  auto cache = full_cache();
+  EXPECT_TRUE(cache->put(key(10), 10, 20));
+  EXPECT_TRUE(cache->contains(key(10)));
+  EXPECT_FALSE(cache->contains(key(0)));
+  EXPECT_FALSE(cache->contains(key(1)));
+  for (int i = 2; i < 10; ++i) {
+    EXPECT_TRUE(cache->contains(key(i))) << i;
+  }
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.size, 9);
+  EXPECT_EQ(stats.weight, 100);
+  EXPECT_EQ(stats.evictions, 2);
+
+  // Next insert evicts next oldest, not entry inserted last.
+  EXPECT_TRUE(cache->put(key(11), 11, 10));
+  EXPECT_TRUE(cache->contains(key(10)));
+  EXPECT_TRUE(cache->contains(key(11)));
+  EXPECT_FALSE(cache->contains(key(2)));
+}
+
+TEST(BytesCache, ReferencedEntrySurvivesSweep) {
+  auto cache = full_cache();
+  EXPECT_EQ(cache->get(key(0)), 0);
+  EXPECT_TRUE(cache->put(key(10), 10, 10));
+  EXPECT_TRUE(cache->contains(key(0)));
+  EXPECT_FALSE(cache->contains(key(1)));
+  EXPECT_TRUE(cache->contains(key(10)));
+}
+
+TEST(BytesCache, ReplaceKeepsEntry) {
+  auto cache = full_cache();
+  EXPECT_TRUE(cache->put(key(9), 90, 30));
+  EXPECT_EQ(cache->get(key(9)), 90);
+  EXPECT_FALSE(cache->contains(key(0)));
+  EXPECT_FALSE(cache->contains(key(1)));
+  EXPECT_EQ(cache->stats().weight, 100);
+}
+
+TEST(BytesCache, RejectsValueOverCapacity) {
+  auto cache = full_cache();
+  EXPECT_FALSE(cache->put(key(5), 5, 101));
+  EXPECT_FALSE(cache->contains(key(5)));
+  EXPECT_EQ(cache->stats().size, 9);
+}
+
+// Entry filling erased slot is still newest.
+TEST(BytesCache, InsertAfterEraseEvictsOldest) {
+  auto cache = full_cache();
+  EXPECT_TRUE(cache->erase(key(0)));
+  EXPECT_TRUE(cache->put(key(10), 10, 10));
+  EXPECT_TRUE(cache->put(key(11), 11, 10));
+  EXPECT_TRUE(cache->contains(key(10)));
+  EXPECT_TRUE(cache->contains(key(11)));
+  EXPECT_FALSE(cache->contains(key(1)));
+  EXPECT_TRUE(cache->contains(key(2)));
+}
+
+// Ring compaction keeps order and positions used by erase.
+TEST(BytesCache, ChurnKeepsInsertionOrder) {
+  Cache cache{100, 1};
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(cache.put(key(i % 256), i, 10));
+    if (i % 3 == 1) {
+      EXPECT_TRUE(cache.erase(key(i % 256)));
+    }
+  }
+  // Last 10 inserted keys not erased are cached.
+  int cached = 0;
+  for (int i = 999; i >= 0 and cached < 10; --i) {
+    if (i % 3 != 1) {
+      EXPECT_EQ(cache.get(key(i % 256)), i);
+      ++cached;
+    }
+  }
+  EXPECT_EQ(cache.stats().size, 10);
+  EXPECT_EQ(cache.stats().weight, 100);
+}
+
+// Default sharding leaves room for large values, e.g. runtime code.
+TEST(BytesCache, DefaultShardsFitLargeValue) {
+  Cache cache{64 << 20};
+  EXPECT_GE(cache.shard_capacity(), Cache::kMinShardCapacity);
+  EXPECT_TRUE(cache.put(key(0), 0, Cache::kMinShardCapacity));
+  EXPECT_TRUE(cache.contains(key(0)));
+
+  Cache small{100};
+  EXPECT_EQ(small.shard_count(), 1);
+  EXPECT_EQ(small.shard_capacity(), 100);
+}
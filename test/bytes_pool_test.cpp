@@ -0,0 +1,38 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <qtils/bytes_pool.hpp>
+
+using qtils::BytesPool;
+using qtils::PooledBytes;
+
+TEST(BytesPool, ReusesReleasedBlock) {
+  std::thread{[] {
+    auto data = PooledBytes{1000}.data();
+    PooledBytes bytes{1000};
+    EXPECT_EQ(bytes.data(), data);
+    EXPECT_EQ(bytes.capacity(), 1024);
+  }}.join();
+}
+
+// thread_local constructed before thread cache is destroyed after it.
+TEST(BytesPool, ReleaseAfterThreadCacheDestroyed) {
+  auto &pool = BytesPool::instance();
+  pool.trim();
+  auto before = pool.stats();
+  std::thread{[] {
+    thread_local PooledBytes late;
+    late.resize(1000);
+  }}.join();
+  auto after = pool.stats();
+  EXPECT_EQ(after.retained, before.retained + 1024);
+  EXPECT_EQ(after.misses, before.misses + 1);
+  pool.trim();
+}
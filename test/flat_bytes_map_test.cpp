@@ -0,0 +1,182 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include <qtils/flat_bytes_map.hpp>
+
+namespace {
+  using Key = qtils::BytesN<32>;
+  using Map = qtils::FlatBytesMap<32, int>;
+
+  Key key(uint32_t i) {
+    Key key{};
+    // Spread into hashed bytes of `RandomBytesHash`.
+    for (size_t j = 0; j < key.size(); j += 4) {
+      auto x = (i + 1) * 0x9e3779b9u ^ j;
+      memcpy(key.data() + j, &x, 4);
+    }
+    return key;
+  }
+
+  std::map<Key, int> items(const Map &map) {
+    std::map<Key, int> items;
+    for (auto &[k, v] : map) {
+      EXPECT_TRUE(items.emplace(k, v).second);
+    }
+    return items;
+  }
+
+  // Every key shares probe sequence and control byte.
+  struct CollidingHash {
+    size_t operator()(qtils::BytesIn) const {
+      return 42;
+    }
+  };
+}  // namespace
+
+TEST(FlatBytesMap, ChurnReusesTombstones) {
+  Map map{100};
+  auto capacity = map.capacity();
+  std::map<Key, int> expected;
+  for (uint32_t i = 0; i < 100000; ++i) {
+    map.try_emplace(key(i), i);
+    expected.emplace(key(i), i);
+    if (i >= 50) {
+      EXPECT_EQ(map.erase(key(i - 50)), 1);
+      expected.erase(key(i - 50));
+    }
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+  EXPECT_EQ(items(map), expected);
+
+  // Same key erased and inserted again.
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(map.erase(key(7)), i == 0 ? 0 : 1);
+    EXPECT_TRUE(map.try_emplace(key(7), i).second);
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+  EXPECT_EQ(map.find(key(7))->second, 999);
+}
+
+// Regression: reserve ignored tombstones and inserts still rehashed.
+TEST(FlatBytesMap, ReserveAfterEraseDoesNotRehash) {
+  // Key `i` goes to slot `i`, so new keys can't reuse tombstones.
+  struct SlotHash {
+    size_t operator()(qtils::BytesIn key) const {
+      size_t i;
+      memcpy(&i, key.data(), sizeof(i));
+      return i << 7;
+    }
+  };
+  auto slot_key = [](size_t i) {
+    Key key{};
+    memcpy(key.data(), &i, sizeof(i));
+    return key;
+  };
+  qtils::FlatBytesMap<32, int, SlotHash> map{1700};
+  ASSERT_EQ(map.capacity(), 2048);
+  for (size_t i = 0; i < 1700; ++i) {
+    map.try_emplace(slot_key(i), i);
+  }
+  for (size_t i = 1; i < 1700; ++i) {
+    map.erase(slot_key(i));
+  }
+  map.reserve(1000);
+  auto capacity = map.capacity();
+  auto value = &map.find(slot_key(0))->second;
+  for (size_t i = 1700; map.size() < 1000; ++i) {
+    map.try_emplace(slot_key(i), i);
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+  EXPECT_EQ(&map.find(slot_key(0))->second, value);
+}
+
+TEST(FlatBytesMap, RehashAfterEraseShrinks) {
+  Map map;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    map.try_emplace(key(i), i);
+  }
+  for (uint32_t i = 0; i < 990; ++i) {
+    map.erase(key(i));
+  }
+  map.rehash(0);
+  EXPECT_EQ(map.capacity(), 16);
+  EXPECT_EQ(map.size(), 10);
+  for (uint32_t i = 990; i < 1000; ++i) {
+    EXPECT_EQ(map.find(key(i))->second, i);
+  }
+}
+
+TEST(FlatBytesMap, CopyAndMove) {
+  Map map;
+  for (uint32_t i = 0; i < 100; ++i) {
+    map.try_emplace(key(i), i);
+  }
+  for (uint32_t i = 0; i < 100; i += 2) {
+    map.erase(key(i));
+  }
+  auto copy = map;
+  EXPECT_EQ(items(copy), items(map));
+  copy.erase(key(1));
+  copy.try_emplace(key(0), 0);
+  EXPECT_TRUE(map.contains(key(1)));
+  EXPECT_FALSE(map.contains(key(0)));
+
+  auto expected = items(map);
+  auto moved = std::move(map);
+  EXPECT_EQ(items(moved), expected);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  map = moved;
+  EXPECT_EQ(items(map), expected);
+  copy = std::move(moved);
+  EXPECT_EQ(items(copy), expected);
+}
+
+TEST(FlatBytesMap, EraseWhileIterating) {
+  Map map;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    map.try_emplace(key(i), i);
+  }
+  size_t visited = 0;
+  for (auto it = map.begin(); it != map.end(); ++visited) {
+    if (it->second % 2 == 0) {
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(visited, 1000);
+  EXPECT_EQ(map.size(), 500);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(map.contains(key(i)), i % 2 != 0) << i;
+  }
+}
+
+TEST(FlatBytesMap, CollidingHash) {
+  qtils::FlatBytesMap<32, int, CollidingHash> map;
+  for (uint32_t i = 0; i < 200; ++i) {
+    EXPECT_TRUE(map.try_emplace(key(i), i).second);
+  }
+  for (uint32_t i = 0; i < 200; i += 3) {
+    EXPECT_EQ(map.erase(key(i)), 1);
+  }
+  for (uint32_t i = 0; i < 200; ++i) {
+    auto it = map.find(key(i));
+    if (i % 3 == 0) {
+      EXPECT_EQ(it, map.end());
+    } else {
+      ASSERT_NE(it, map.end());
+      EXPECT_EQ(it->second, i);
+    }
+  }
+  EXPECT_FALSE(map.try_emplace(key(1), 0).second);
+  EXPECT_TRUE(map.try_emplace(key(0), 0).second);
+  EXPECT_EQ(map.size(), 134);
+}
@@ -0,0 +1,110 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <qtils/bytes_compare.hpp>
+#include <qtils/radix_sort.hpp>
+
+using qtils::Bytes;
+
+namespace {
+  // Key with original position, to check stability.
+  struct Item {
+    operator qtils::BytesIn() const {
+      return key;
+    }
+    bool operator==(const Item &) const = default;
+
+    Bytes key;
+    size_t index;
+  };
+
+  /**
+   * Short keys over few byte values, so many are empty, equal or prefixes
+   * of each other.
+   */
+  std::vector<Item> random_items(size_t size, uint32_t seed) {
+    std::mt19937 rng{seed};
+    std::vector<Item> items(size);
+    for (size_t i = 0; i < size; ++i) {
+      items[i].key.resize(rng() % 5);
+      for (auto &byte : items[i].key) {
+        byte = std::array{0x00, 0x01, 0x7f, 0xff}[rng() % 4];
+      }
+      items[i].index = i;
+    }
+    return items;
+  }
+
+  bool less(const Item &l, const Item &r) {
+    return qtils::BytesLess{}(l.key, r.key);
+  }
+
+  std::vector<Bytes> keys(const std::vector<Item> &items) {
+    std::vector<Bytes> keys;
+    for (auto &item : items) {
+      keys.emplace_back(item.key);
+    }
+    return keys;
+  }
+
+  // Sizes below and above comparison sort cutoff and parallel threshold.
+  constexpr size_t kSizes[] = {0, 1, 2, 64, 65, 1000, (1 << 16) + 7};
+}  // namespace
+
+TEST(RadixSort, MatchesStdSort) {
+  for (auto size : kSizes) {
+    for (size_t threads : {1, 4}) {
+      auto items = random_items(size, size);
+      auto expected = items;
+      std::ranges::sort(expected, less);
+      qtils::radix_sort(items, threads);
+      EXPECT_EQ(keys(items), keys(expected)) << size << " " << threads;
+    }
+  }
+}
+
+TEST(RadixSort, StableMatchesStdStableSort) {
+  for (auto size : kSizes) {
+    for (size_t threads : {1, 4}) {
+      auto items = random_items(size, size);
+      auto expected = items;
+      std::ranges::stable_sort(expected, less);
+      qtils::stable_radix_sort(items, threads);
+      EXPECT_EQ(items, expected) << size << " " << threads;
+    }
+  }
+}
+
+TEST(RadixSort, EqualKeys) {
+  std::vector<Item> items;
+  for (size_t i = 0; i < 1000; ++i) {
+    items.push_back({Bytes(i % 2 == 0 ? 0 : 40, 0x55), i});
+  }
+  auto expected = items;
+  std::ranges::stable_sort(expected, less);
+  qtils::stable_radix_sort(items);
+  EXPECT_EQ(items, expected);
+  qtils::radix_sort(items);
+  EXPECT_EQ(keys(items), keys(expected));
+}
+
+TEST(RadixSort, FixedSizeKeys) {
+  std::mt19937 rng{1};
+  std::vector<qtils::BytesN<32>> hashes(100000);
+  for (auto &hash : hashes) {
+    for (auto &byte : hash) {
+      byte = rng();
+    }
+  }
+  auto expected = hashes;
+  std::ranges::sort(expected);
+  qtils::radix_sort(hashes, 4);
+  EXPECT_EQ(hashes, expected);
+}
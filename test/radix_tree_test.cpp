@@ -0,0 +1,182 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+#include <qtils/bytes_compare.hpp>
+#include <qtils/radix_tree.hpp>
+
+using qtils::Bytes;
+
+namespace {
+  using Tree = qtils::RadixTree<int>;
+  using Map = std::map<Bytes, int, qtils::BytesLess>;
+  using Items = std::vector<std::pair<Bytes, int>>;
+
+  Bytes bytes(std::string_view s) {
+    return {s.begin(), s.end()};
+  }
+
+  template <typename Range>
+  Items items(const Range &range) {
+    Items items;
+    for (auto &&[key, value] : range) {
+      items.emplace_back(Bytes{key.begin(), key.end()}, value);
+    }
+    return items;
+  }
+
+  void expect_same(const Tree &tree, const Map &map) {
+    EXPECT_EQ(tree.size(), map.size());
+    EXPECT_EQ(items(tree), items(map));
+    for (auto &[key, value] : map) {
+      auto found = tree.find(key);
+      ASSERT_NE(found, nullptr);
+      EXPECT_EQ(*found, value);
+    }
+  }
+
+  // Key under shared 40-byte prefix, longer than inline node prefix.
+  Bytes child_key(uint8_t byte) {
+    Bytes key(40, 0xab);
+    key.push_back(byte);
+    key.push_back(0x01);
+    return key;
+  }
+}  // namespace
+
+// Node4 -> Node16 -> Node48 -> Node256 and back.
+TEST(RadixTree, GrowAndShrinkNodes) {
+  Tree tree;
+  Map map;
+  for (int i = 0; i < 256; ++i) {
+    // Spread bytes so sorted nodes insert in the middle.
+    auto byte = static_cast<uint8_t>(i * 167);
+    EXPECT_TRUE(tree.try_emplace(child_key(byte), i).second);
+    map.emplace(child_key(byte), i);
+    expect_same(tree, map);
+  }
+  for (int i = 0; i < 256; ++i) {
+    auto byte = static_cast<uint8_t>(i * 71);
+    EXPECT_EQ(tree.erase(child_key(byte)), 1);
+    EXPECT_EQ(tree.erase(child_key(byte)), 0);
+    map.erase(child_key(byte));
+    expect_same(tree, map);
+  }
+  EXPECT_TRUE(tree.empty());
+  EXPECT_EQ(tree.begin(), tree.end());
+}
+
+TEST(RadixTree, SplitAndCollapsePrefix) {
+  Tree tree;
+  Map map;
+  auto add = [&](std::string_view key, int value) {
+    EXPECT_TRUE(tree.try_emplace(bytes(key), value).second);
+    map.emplace(bytes(key), value);
+    expect_same(tree, map);
+  };
+  auto remove = [&](std::string_view key) {
+    EXPECT_EQ(tree.erase(bytes(key)), 1);
+    map.erase(bytes(key));
+    expect_same(tree, map);
+  };
+  add("storage:system:account", 1);
+  // Splits leaf.
+  add("storage:system:events", 2);
+  // Splits node prefix.
+  add("storage:balances", 3);
+  // Key ending at node.
+  add("storage:system:", 4);
+  // Key which is prefix of leaf.
+  add("storage:balances:total", 5);
+  add("", 6);
+  EXPECT_FALSE(tree.try_emplace(bytes("storage:system:"), 0).second);
+  EXPECT_FALSE(tree.contains(bytes("storage:")));
+  EXPECT_FALSE(tree.contains(bytes("storage:system:account:")));
+
+  remove("storage:system:events");
+  remove("storage:system:");
+  remove("storage:balances");
+  EXPECT_EQ(*tree.find(bytes("storage:system:account")), 1);
+  remove("storage:system:account");
+  remove("");
+  remove("storage:balances:total");
+  EXPECT_TRUE(tree.empty());
+
+  // Collapsed tree is still usable.
+  add("storage:system:account", 7);
+  add("storage:system:events", 8);
+}
+
+TEST(RadixTree, LowerBoundAbsentKey) {
+  Tree tree;
+  for (auto key : {"ab", "abc", "abd", "b", "ba"}) {
+    tree.try_emplace(bytes(key), 0);
+  }
+  auto lower_bound = [&](std::string_view key) {
+    auto it = tree.lower_bound(bytes(key));
+    return it == tree.end() ? Bytes{} : Bytes{it.key().begin(),
+                                            it.key().end()};
+  };
+  EXPECT_EQ(lower_bound(""), bytes("ab"));
+  EXPECT_EQ(lower_bound("a"), bytes("ab"));
+  EXPECT_EQ(lower_bound("ab"), bytes("ab"));
+  EXPECT_EQ(lower_bound({"ab\0", 3}), bytes("abc"));
+  EXPECT_EQ(lower_bound("abcc"), bytes("abd"));
+  EXPECT_EQ(lower_bound("abe"), bytes("b"));
+  EXPECT_EQ(lower_bound("azz"), bytes("b"));
+  EXPECT_EQ(lower_bound("b\xff"), Bytes{});
+  EXPECT_EQ(tree.lower_bound(bytes("c")), tree.end());
+}
+
+TEST(RadixTree, PrefixIteration) {
+  Tree tree;
+  Map map;
+  for (auto key : {"", "a", "ab", "abc", "abd", "b", "b\xff", "c"}) {
+    tree.try_emplace(bytes(key), static_cast<int>(map.size()));
+    map.emplace(bytes(key), static_cast<int>(map.size()));
+  }
+  auto expected = [&](std::string_view s) {
+    auto prefix = bytes(s);
+    Items items;
+    for (auto &[key, value] : map) {
+      if (key.size() >= prefix.size()
+          and std::equal(prefix.begin(), prefix.end(), key.begin())) {
+        items.emplace_back(key, value);
+      }
+    }
+    return items;
+  };
+  EXPECT_EQ(items(tree.prefix({})), items(map));
+  for (auto prefix : {"a", "ab", "abc", "abx", "b", "b\xff", "x"}) {
+    EXPECT_EQ(items(tree.prefix(bytes(prefix))), expected(prefix)) << prefix;
+  }
+  EXPECT_TRUE(items(tree.prefix(bytes("abx"))).empty());
+  EXPECT_EQ(items(tree.prefix(bytes("ab"))).size(), 3);
+}
+
+TEST(RadixTree, MatchesMapOnRandomKeys) {
+  std::mt19937 rng{1};
+  Tree tree;
+  Map map;
+  for (int i = 0; i < 20000; ++i) {
+    Bytes key(rng() % 6, 0);
+    for (auto &byte : key) {
+      // Few distinct bytes, so keys share prefixes.
+      byte = rng() % 4 * 64;
+    }
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(tree.erase(key), map.erase(key));
+    } else {
+      tree.insert_or_assign(key, i);
+      map.insert_or_assign(key, i);
+    }
+  }
+  expect_same(tree, map);
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <qtils/unhex_stream.hpp>
+
+using qtils::Bytes;
+using qtils::UnhexError;
+using qtils::UnhexStream;
+
+namespace {
+  // Feeds chunks to stateful sink, returns decoded bytes.
+  outcome::result<Bytes> decode(
+      UnhexStream &stream, std::initializer_list<std::string_view> chunks) {
+    Bytes out;
+    for (auto chunk : chunks) {
+      OUTCOME_TRY(stream.feed(chunk, [&out](qtils::BytesIn bytes) mutable {
+        out.insert(out.end(), bytes.begin(), bytes.end());
+      }));
+    }
+    OUTCOME_TRY(stream.finish());
+    return out;
+  }
+}  // namespace
+
+TEST(UnhexStream, MutableSink) {
+  UnhexStream stream;
+  size_t calls = 0;
+  Bytes out;
+  auto sink = [calls, &out](qtils::BytesIn bytes) mutable {
+    ++calls;
+    out.insert(out.end(), bytes.begin(), bytes.end());
+  };
+  EXPECT_TRUE(stream.feed("0102", sink).has_value());
+  EXPECT_TRUE(stream.feed("03", std::move(sink)).has_value());
+  EXPECT_EQ(out, (Bytes{1, 2, 3}));
+}
+
+TEST(UnhexStream, PrefixSplitAcrossChunks) {
+  UnhexStream stream{UnhexStream::Prefix0x::REQUIRED};
+  EXPECT_EQ(decode(stream, {"0", "x", "ab", "cd"}).value(),
+      (Bytes{0xab, 0xcd}));
+
+  UnhexStream optional{UnhexStream::Prefix0x::OPTIONAL};
+  EXPECT_EQ(decode(optional, {"0", "1ab"}).value(), (Bytes{0x01, 0xab}));
+
+  UnhexStream forbidden;
+  EXPECT_EQ(decode(forbidden, {"0", "x12"}).error(),
+      UnhexError::UNEXPECTED_0X);
+
+  UnhexStream missing{UnhexStream::Prefix0x::REQUIRED};
+  EXPECT_EQ(decode(missing, {"1", "2"}).error(), UnhexError::REQUIRED_0X);
+}
+
+TEST(UnhexStream, OddNibbleCarriedAcrossChunks) {
+  UnhexStream stream;
+  EXPECT_EQ(decode(stream, {"a", "bc", "d", "", "e", "f"}).value(),
+      (Bytes{0xab, 0xcd, 0xef}));
+}
+
+TEST(UnhexStream, ErrorIsSticky) {
+  UnhexStream stream;
+  uint8_t out[4];
+  EXPECT_EQ(stream.feed("01", out).value(), 1);
+  EXPECT_EQ(stream.feed("zz", out).error(), UnhexError::NON_HEX);
+  EXPECT_EQ(stream.feed("02", out).error(), UnhexError::NON_HEX);
+  EXPECT_EQ(stream.finish().error(), UnhexError::NON_HEX);
+}
+
+TEST(UnhexStream, FinishReportsOddLength) {
+  UnhexStream stream;
+  uint8_t out[4];
+  EXPECT_EQ(stream.feed("012", out).value(), 1);
+  EXPECT_EQ(stream.finish().error(), UnhexError::ODD_LENGTH);
+
+  // Single char still buffered for prefix check.
+  UnhexStream head{UnhexStream::Prefix0x::OPTIONAL};
+  EXPECT_EQ(head.feed("0", out).value(), 0);
+  EXPECT_EQ(head.finish().error(), UnhexError::ODD_LENGTH);
+}
@@ -0,0 +1,41 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <qtils/arena.hpp>
+#include <qtils/unhex.hpp>
+
+using qtils::Arena;
+using qtils::UnhexError;
+using qtils::unhex0x;
+
+template <typename T, typename... A>
+concept CanUnhex0x = requires(A... a) { unhex0x<T>("0x", a...); };
+
+TEST(Unhex, Unhex0xUsesArena) {
+  Arena arena;
+  auto r = unhex0x<qtils::pmr::Bytes>("0x0102", &arena);
+  ASSERT_TRUE(r.has_value());
+  EXPECT_EQ(r.value().get_allocator().resource(), &arena);
+  EXPECT_EQ(r.value(), (qtils::pmr::Bytes{1, 2}));
+}
+
+TEST(Unhex, Unhex0xWithArenaRequiresPrefix) {
+  Arena arena;
+  EXPECT_EQ(unhex0x<qtils::pmr::Bytes>("0102", &arena).error(),
+      UnhexError::REQUIRED_0X);
+  auto r = unhex0x<qtils::pmr::Bytes>("0102", &arena, true);
+  ASSERT_TRUE(r.has_value());
+  EXPECT_EQ(r.value().get_allocator().resource(), &arena);
+}
+
+TEST(Unhex, Unhex0xRejectsPointerAsFlag) {
+  static_assert(not CanUnhex0x<qtils::Bytes, const char *>);
+  static_assert(not CanUnhex0x<qtils::pmr::Bytes, const char *>);
+  static_assert(CanUnhex0x<qtils::pmr::Bytes, Arena *>);
+  static_assert(CanUnhex0x<qtils::Bytes, bool>);
+}